@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+"""Throughput benchmark of example B1.
+
+Runs each workload macro of this directory with fixed seeds at 1, 2, 4, ...
+threads and writes one JSON report with, per run: events/s, the event time
+percentiles (from the B1 profiler, event phases only), the peak RSS and the
+parallel efficiency relative to the single thread run.
+
+    run_bench.py --exe ./exampleB1 [--threads 1,2,4,8] [--scale 1.0]
+                 [--workloads co57,gamma14] [--output bench.json]
+                 [--compare reference.json --tolerance 0.05]
+
+With --compare, the events/s of each run are compared to a previous report
+and the script exits with status 1 if any of them dropped by more than the
+tolerance.
+"""
+
+import argparse
+import json
+import os
+import platform
+import re
+import subprocess
+import sys
+import time
+
+# workload name -> number of events at scale 1
+WORKLOADS = {
+    "co57":      100000,
+    "gamma14":   200000,
+    "gamma122":  100000,
+    "gamma6MeV":  20000,
+    "proton210":   2000,
+}
+
+BENCH_DIR = os.path.dirname(os.path.abspath(__file__))
+
+
+def default_threads():
+    ncpu = os.cpu_count() or 1
+    threads, n = [], 1
+    while n < ncpu:
+        threads.append(n)
+        n *= 2
+    threads.append(ncpu)
+    return threads
+
+
+def run_one(exe, workload, threads, events, workdir):
+    tag = "bench_%s_t%d" % (workload, threads)
+    env = dict(os.environ,
+               B1_BENCH_THREADS=str(threads),
+               B1_BENCH_EVENTS=str(events),
+               B1_BENCH_PROFILE=tag)
+    log_name = os.path.join(workdir, tag + ".log")
+    macro = os.path.join(BENCH_DIR, workload + ".mac")
+
+    start = time.perf_counter()
+    with open(log_name, "w") as log:
+        proc = subprocess.Popen([exe, macro], cwd=workdir, env=env,
+                                stdout=log, stderr=subprocess.STDOUT)
+        _, status, usage = os.wait4(proc.pid, 0)
+    wall = time.perf_counter() - start
+    if status != 0:
+        sys.exit("%s failed, see %s" % (tag, log_name))
+
+    # event loop time from the master run summary (the worker output is
+    # prefixed with G4WT), if printed
+    real = []
+    with open(log_name) as log:
+        for line in log:
+            if not line.startswith("G4WT"):
+                real += re.findall(r"Real=([0-9.eE+-]+)s", line)
+    loop = float(real[-1]) if real else wall
+
+    result = {
+        "threads": threads,
+        "events": events,
+        "wall_s": wall,
+        "event_loop_s": loop,
+        "events_per_s": events / loop if loop > 0 else 0.,
+        "peak_rss_mb": usage.ru_maxrss / 1024.,
+    }
+    try:
+        with open(os.path.join(workdir, tag + ".json")) as f:
+            profile = json.load(f)
+        result["event_time_us"] = dict(
+            (k, 1.e6 * v) for k, v in profile["event_time_percentiles"].items())
+    except (IOError, KeyError, ValueError):
+        pass
+    return result
+
+
+def compare(report, reference, tolerance):
+    failed = False
+    for workload, runs in report["workloads"].items():
+        ref_runs = dict((r["threads"], r)
+                        for r in reference.get("workloads", {}).get(workload, []))
+        for run in runs:
+            ref = ref_runs.get(run["threads"])
+            if not ref or ref["events_per_s"] <= 0.:
+                continue
+            ratio = run["events_per_s"] / ref["events_per_s"]
+            flag = ""
+            if ratio < 1. - tolerance:
+                flag, failed = "  REGRESSION", True
+            print("%-10s %3d threads : %10.1f ev/s, %6.3f x reference%s"
+                  % (workload, run["threads"], run["events_per_s"], ratio, flag))
+    return failed
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--exe", default="./exampleB1")
+    parser.add_argument("--threads", default=None,
+                        help="comma separated thread counts (default 1,2,4,...,ncpu)")
+    parser.add_argument("--scale", type=float, default=1.0,
+                        help="scale factor of the number of events")
+    parser.add_argument("--workloads", default=",".join(WORKLOADS))
+    parser.add_argument("--workdir", default="bench_runs")
+    parser.add_argument("--output", default="bench.json")
+    parser.add_argument("--compare", default=None)
+    parser.add_argument("--tolerance", type=float, default=0.05)
+    args = parser.parse_args()
+
+    exe = os.path.abspath(args.exe)
+    threads = ([int(t) for t in args.threads.split(",")] if args.threads
+               else default_threads())
+    if not os.path.isdir(args.workdir):
+        os.makedirs(args.workdir)
+
+    report = {
+        "executable": exe,
+        "host": platform.node(),
+        "cpus": os.cpu_count(),
+        "date": time.strftime("%Y-%m-%dT%H:%M:%S"),
+        "workloads": {},
+    }
+    for workload in args.workloads.split(","):
+        events = max(1, int(WORKLOADS[workload] * args.scale))
+        runs = []
+        for n in threads:
+            run = run_one(exe, workload, n, events, args.workdir)
+            runs.append(run)
+            print("%-10s %3d threads : %10.1f ev/s, peak RSS %7.1f MB"
+                  % (workload, n, run["events_per_s"], run["peak_rss_mb"]))
+        single = [r for r in runs if r["threads"] == 1]
+        for run in runs:
+            if single and single[0]["events_per_s"] > 0.:
+                run["parallel_efficiency"] = (run["events_per_s"]
+                    / (run["threads"] * single[0]["events_per_s"]))
+        report["workloads"][workload] = runs
+
+    with open(args.output, "w") as f:
+        json.dump(report, f, indent=2)
+    print("report written to " + args.output)
+
+    if args.compare:
+        with open(args.compare) as f:
+            reference = json.load(f)
+        if compare(report, reference, args.tolerance):
+            sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,18 @@
+#!/bin/sh
+#
+# Run compare_physics.mac with the default and the low-energy physics
+# lists, report the run times and compare the two ESpec spectra with
+# ComparePhysics.C.
+#
+# usage: ./compare_physics.sh [path to exampleB1]
+#
+EXE=${1:-./exampleB1}
+
+for list in standard lowenergy; do
+  echo "=== ${list} physics list"
+  B1_PHYSLIST=${list} ${EXE} compare_physics.mac > compare_${list}.log 2>&1 \
+    || { echo "run failed, see compare_${list}.log"; exit 1; }
+  grep -A2 "Run Summary" compare_${list}.log | tail -n 2
+done
+
+root -l -b -q 'ComparePhysics.C("B1out_standard.root","B1out_lowenergy.root")'
@@ -30,80 +30,264 @@
 #include "B1DetectorConstruction.hh"
 #include "B1ActionInitialization.hh"
 #include "B1PhysicsList.hh"
+#include "B1LowEnergyPhysicsList.hh"
+#include "B1WorkerInitialization.hh"
+#include "B1ShardLauncher.hh"
 
 #include "G4RunManagerFactory.hh"
+#include "G4MTRunManager.hh"
 
 #include "G4UImanager.hh"
+#include "G4UIcommand.hh"
+#include "G4StateManager.hh"
 #include "QBBC.hh"
 
+#ifndef B1_BATCH
 #include "G4VisExecutive.hh"
 #include "G4UIExecutive.hh"
+#endif
 
 #include "Randomize.hh"
 
+#include <cstdlib>
+#include <sstream>
+
+namespace {
+  void PrintUsage() {
+    G4cerr << " Usage: " << G4endl;
+    G4cerr << " exampleB1 [-m macro ] [-r serial|mt|tasking] [-t nThreads]"
+           << " [-n nEvents]" << G4endl;
+    G4cerr << "           [-o output] [-s seed] [-p standard|lowenergy]"
+           << " [-a none|core|numa] [-j nShards] [-u UIsession]" << G4endl;
+#ifdef B1_BATCH
+    G4cerr << "   (exampleB1_batch: -m or -n is required, -u is ignored)"
+           << G4endl;
+#endif
+    G4cerr << " exampleB1 macro" << G4endl;
+    G4cerr << "   -r : run manager type (default: Geant4 default)" << G4endl;
+    G4cerr << "   -n : events run after the macro" << G4endl;
+    G4cerr << "   -o : output file name, as /B1/output/fileName" << G4endl;
+    G4cerr << "   -a : pin the worker threads to one CPU (core) or one NUMA"
+           << " node (numa) of the process cpuset" << G4endl;
+    G4cerr << "   -j : split the -n events over nShards processes and merge"
+           << " their spectra" << G4endl;
+  }
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 int main(int argc,char** argv)
 {
-  // Detect interactive mode (if no arguments) and define UI session
+  // Evaluate arguments; a single argument without dash is a macro
+  //
+  G4String macro;
+  G4String session;
+  G4String runManagerName = "default";
+  G4String output;
+  G4String affinity = "none";
+  G4String physListName;
+  const char* physListEnv = std::getenv("B1_PHYSLIST");
+  if ( physListEnv ) physListName = physListEnv;
+  G4int nofThreads = 0;
+  G4int nofEvents = 0;
+  G4int nofShards = 1;
+  G4long seed = 0;
+  if ( argc == 2 && argv[1][0] != '-' ) {
+    macro = argv[1];
+  }
+  else {
+    for ( G4int i=1; i<argc; i=i+2 ) {
+      if ( i+1 >= argc ) {
+        PrintUsage();
+        return 1;
+      }
+      G4String option = argv[i];
+      if      ( option == "-m" ) macro = argv[i+1];
+      else if ( option == "-u" ) session = argv[i+1];
+      else if ( option == "-r" ) runManagerName = argv[i+1];
+      else if ( option == "-t" ) nofThreads = G4UIcommand::ConvertToInt(argv[i+1]);
+      else if ( option == "-n" ) nofEvents = G4UIcommand::ConvertToInt(argv[i+1]);
+      else if ( option == "-o" ) output = argv[i+1];
+      else if ( option == "-s" ) seed = std::atol(argv[i+1]);
+      else if ( option == "-p" ) physListName = argv[i+1];
+      else if ( option == "-a" ) affinity = argv[i+1];
+      else if ( option == "-j" ) nofShards = G4UIcommand::ConvertToInt(argv[i+1]);
+      else {
+        PrintUsage();
+        return 1;
+      }
+    }
+  }
+
+  G4RunManagerType runManagerType = G4RunManagerType::Default;
+  if      ( runManagerName == "serial" )  runManagerType = G4RunManagerType::Serial;
+  else if ( runManagerName == "mt" )      runManagerType = G4RunManagerType::MT;
+  else if ( runManagerName == "tasking" ) runManagerType = G4RunManagerType::Tasking;
+  else if ( runManagerName != "default" ) {
+    PrintUsage();
+    return 1;
+  }
+
+  B1WorkerInitialization::AffinityMode affinityMode
+    = B1WorkerInitialization::kAffinityNone;
+  if      ( affinity == "core" ) affinityMode = B1WorkerInitialization::kAffinityCore;
+  else if ( affinity == "numa" ) affinityMode = B1WorkerInitialization::kAffinityNuma;
+  else if ( affinity != "none" ) {
+    PrintUsage();
+    return 1;
+  }
+
+  // Sharded run: the parent forks the shards, waits for them and merges
+  // their summaries; each shard continues below with its own block of
+  // events, random stream, CPUs and output
+  //
+  G4int shard = -1;
+  G4int firstEvent = 0;
+  if ( nofShards > 1 ) {
+    if ( nofEvents < nofShards ) {
+      PrintUsage();
+      return 1;
+    }
+    if ( seed <= 0 ) seed = 1;
+    if ( ! output.size() ) output = "B1out";
+    B1ShardLauncher launcher(nofShards, nofEvents, seed, output);
+    shard = launcher.Launch();
+    if ( shard < 0 ) {
+      return launcher.Merge() ? 0 : 1;
+    }
+    nofEvents = launcher.GetNofEvents(shard);
+    firstEvent = launcher.GetFirstEvent(shard);
+    output = launcher.GetShardName(shard);
+    if ( nofThreads <= 0 ) nofThreads = launcher.GetNofCpus();
+  }
+
+  // Detect interactive mode (no macro and no events) and define UI session;
+  // the batch executable (B1_BATCH) has no UI session and no vis
   //
+#ifndef B1_BATCH
   G4UIExecutive* ui = 0;
-  if ( argc == 1 ) {
-    ui = new G4UIExecutive(argc, argv);
+  if ( ! macro.size() && nofEvents <= 0 ) {
+    ui = new G4UIExecutive(argc, argv, session);
   }
+#else
+  if ( ! macro.size() && nofEvents <= 0 ) {
+    PrintUsage();
+    return 1;
+  }
+#endif
 
   // Optionally: choose a different Random engine...
   // G4Random::setTheEngine(new CLHEP::MTwistEngine);
   
-  // Construct the default run manager
+  // Construct the run manager
   //
   auto* runManager =
-    G4RunManagerFactory::CreateRunManager(G4RunManagerType::Default);
+    G4RunManagerFactory::CreateRunManager(runManagerType);
+  if ( nofThreads > 0 ) {
+    runManager->SetNumberOfThreads(nofThreads);
+  }
+  if ( seed > 0 && shard < 0 ) {
+    // the master engine seeds the events of all workers
+    G4Random::setTheSeed(seed);
+  }
+
+  // Pin the worker threads
+  if ( affinityMode != B1WorkerInitialization::kAffinityNone ) {
+    if ( dynamic_cast<G4MTRunManager*>(runManager) ) {
+      runManager->SetUserInitialization(
+        new B1WorkerInitialization(affinityMode));
+    }
+    else {
+      G4cerr << "Sequential run manager: -a " << affinity << " ignored"
+             << G4endl;
+    }
+  }
 
   // Set mandatory initialization classes
   //
   // Detector construction
   runManager->SetUserInitialization(new B1DetectorConstruction());
 
-  // Physics list
-  G4VModularPhysicsList* physicsList = new PhysicsList();
+  // Physics list: "lowenergy" (-p option, or B1_PHYSLIST at startup)
+  // selects the lean photon/electron list (line source only), anything
+  // else the default list with RDM
+  G4VModularPhysicsList* physicsList = 0;
+  if ( physListName == "lowenergy" ) {
+    physicsList = new LowEnergyPhysicsList();
+  }
+  else {
+    physicsList = new PhysicsList();
+  }
   runManager->SetUserInitialization(physicsList);
     
   // User action initialization
   runManager->SetUserInitialization(new B1ActionInitialization());
   
+#ifndef B1_BATCH
   // Initialize visualization
   //
   G4VisManager* visManager = new G4VisExecutive;
   // G4VisExecutive can take a verbosity argument - see /vis/verbose guidance.
   // G4VisManager* visManager = new G4VisExecutive("Quiet");
   visManager->Initialize();
+#endif
 
   // Get the pointer to the User Interface manager
   G4UImanager* UImanager = G4UImanager::GetUIpointer();
 
+  // Output file name, before the macro which may still change it
+  if ( output.size() ) {
+    UImanager->ApplyCommand("/B1/output/fileName " + output);
+  }
+  if ( shard >= 0 ) {
+    UImanager->ApplyCommand("/B1/output/summaryFile " + output + ".sum");
+  }
+
   // Process macro or start UI session
   //
-  if ( ! ui ) { 
-    // batch mode
-    G4String command = "/control/execute ";
-    G4String fileName = argv[1];
-    UImanager->ApplyCommand(command+fileName);
-  }
-  else { 
+#ifndef B1_BATCH
+  if ( ui ) {
     // interactive mode
     UImanager->ApplyCommand("/control/execute init_vis.mac");
     ui->SessionStart();
     delete ui;
   }
+  else
+#endif
+  {
+    // batch mode
+    if ( macro.size() ) {
+      G4String command = "/control/execute ";
+      UImanager->ApplyCommand(command+macro);
+    }
+    if ( nofEvents > 0 ) {
+      if ( G4StateManager::GetStateManager()->GetCurrentState()
+           == G4State_PreInit ) {
+        runManager->Initialize();
+      }
+      if ( shard >= 0 ) {
+        // seeds from (seed, event number): the shards together give the
+        // same events as a single process; the commands of the worker
+        // actions exist once the run manager is initialized
+        std::ostringstream seeding;
+        seeding << "/B1/random/eventSeeds " << seed;
+        UImanager->ApplyCommand(seeding.str());
+        std::ostringstream first;
+        first << "/B1/random/firstEvent " << firstEvent;
+        UImanager->ApplyCommand(first.str());
+      }
+      runManager->BeamOn(nofEvents);
+    }
+  }
 
   // Job termination
   // Free the store: user actions, physics_list and detector_description are
   // owned and deleted by the run manager, so they should not be deleted 
   // in the main() program !
   
+#ifndef B1_BATCH
   delete visManager;
+#endif
   delete runManager;
 }
 
@@ -32,7 +32,16 @@
 
 #include "G4VUserActionInitialization.hh"
 
+class B1StopCondition;
+class B1ScanGrid;
+class B1ImportanceMap;
+class B1StackFilter;
+
 /// Action initialization class.
+///
+/// It owns the precision target of the runs, the source position scan
+/// grid, the importance map and the stacking filter, shared by the
+/// actions of all threads.
 
 class B1ActionInitialization : public G4VUserActionInitialization
 {
@@ -42,6 +51,12 @@ class B1ActionInitialization : public G4VUserActionInitialization
 
     virtual void BuildForMaster() const;
     virtual void Build() const;
+
+  private:
+    B1StopCondition* fStopCondition;
+    B1ScanGrid*      fScanGrid;
+    B1ImportanceMap* fImportanceMap;
+    B1StackFilter*   fStackFilter;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,73 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1AliasTable.hh
+/// \brief Definition of the B1AliasTable class
+
+#ifndef B1AliasTable_h
+#define B1AliasTable_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+/// Walker alias table for sampling a discrete distribution in constant
+/// time, with a single uniform random number per draw.
+/// The table is built once from the (not necessarily normalised) weights.
+
+class B1AliasTable
+{
+  public:
+    B1AliasTable();
+    explicit B1AliasTable(const std::vector<G4double>& weights);
+   ~B1AliasTable();
+
+    void Build(const std::vector<G4double>& weights);
+
+    // u uniform in [0,1)
+    inline std::size_t Sample(G4double u) const;
+
+    std::size_t GetSize() const { return fProb.size(); }
+    G4double GetTotalWeight() const { return fTotalWeight; }
+
+  private:
+    std::vector<G4double>    fProb;
+    std::vector<std::size_t> fAlias;
+    G4double                 fTotalWeight;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline std::size_t B1AliasTable::Sample(G4double u) const
+{
+  G4double x = u*fProb.size();
+  std::size_t i = std::size_t(x);
+  if (i >= fProb.size()) i = fProb.size() - 1;
+  return (x - i < fProb[i]) ? i : fAlias[i];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
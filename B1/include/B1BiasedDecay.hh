@@ -0,0 +1,84 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1BiasedDecay.hh
+/// \brief Definition of the B1BiasedDecay class
+
+#ifndef B1BiasedDecay_h
+#define B1BiasedDecay_h 1
+
+#include "G4WrapperProcess.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4VPhysicalVolume;
+class G4Cons;
+
+/// Wrapper around the radioactive decay process, which forces the decay
+/// photons towards the Ge crystal.
+///
+/// The cone is centred on the z axis and encloses the front faces of the
+/// crystal (Shape1_1) and of the carbon window (Shape2), as seen from the
+/// decay vertex. Each photon, emitted isotropically by the decay, is sent
+/// into the cone with probability fConeProbability, and outside of it
+/// otherwise, uniformly in solid angle in both cases. The product of the
+/// likelihood ratios of all the photons is the weight of the decay; it is
+/// given to all its products. The decays of a chain (Co-57, then the
+/// excited Fe-57 levels) are biased independently, so the event weight is
+/// the product of the weights of all its decays; it is accumulated in the
+/// B1EventInformation of the event.
+/// With fConeProbability = 1 the photons outside of the cone are never
+/// simulated, which is only unbiased as long as they cannot scatter back
+/// into the crystal.
+
+class B1BiasedDecay : public G4WrapperProcess
+{
+  public:
+    B1BiasedDecay(G4VProcess* decay, G4double coneProbability);
+    virtual ~B1BiasedDecay();
+
+    virtual G4VParticleChange* AtRestDoIt(const G4Track& track,
+                                          const G4Step& step);
+    virtual G4VParticleChange* PostStepDoIt(const G4Track& track,
+                                            const G4Step& step);
+
+  private:
+    void     BiasPhotons(G4VParticleChange* change, const G4Track& track);
+    G4bool   FindTargets();
+    G4double ConeCosine(const G4ThreeVector& vertex) const;
+
+    G4double fConeProbability;
+
+    // target volumes; their front faces are recomputed at each decay,
+    // as the geometry may be modified between runs (/B1/det/)
+    std::vector<const G4VPhysicalVolume*> fTargetVolumes;
+    std::vector<const G4Cons*>            fTargetSolids;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
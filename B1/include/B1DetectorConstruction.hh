@@ -33,10 +33,38 @@
 #include "G4VUserDetectorConstruction.hh"
 #include "globals.hh"
 
+#include <map>
+
 class G4VPhysicalVolume;
 class G4LogicalVolume;
+class G4Cons;
+class B1DetectorMessenger;
 
 /// Detector construction class to define materials and geometry.
+///
+/// The Ge crystal (Shape1_1) is the scoring volume. It is made sensitive
+/// in ConstructSDandField() with a B1GeSD, so that user code is only
+/// called for steps inside the crystal.
+///
+/// The detector volumes are grouped in regions (Crystal, DeadLayer, Window,
+/// Frame) with their own production cuts and optional step limits, set
+/// with the /B1/det/ commands. The world and the air envelope keep the
+/// default cut of the physics list.
+///
+/// The dead layer and window thicknesses and the z positions of the Al
+/// frame and shield are parameters (/B1/det/ commands). Once the geometry
+/// is built, changing them modifies the solids and placements in place and
+/// only flags the geometry for re-optimisation: the physics tables and the
+/// worker threads are kept, so that /B1/det/scan can run many variants in
+/// one process.
+///
+/// The overlaps are checked once the geometry is built, and again after
+/// each change (/B1/det/overlapCheck):
+///  - always : every time
+///  - cached : (default) skipped if the hash of the geometry is listed in
+///             the cache file (/B1/det/overlapCache), where the hash of
+///             each geometry found free of overlaps is appended
+///  - never  : for geometries known to be valid
 
 class B1DetectorConstruction : public G4VUserDetectorConstruction
 {
@@ -46,10 +74,57 @@ class B1DetectorConstruction : public G4VUserDetectorConstruction
 
     virtual G4VPhysicalVolume* Construct();
     
+    virtual void ConstructSDandField();
+    
     G4LogicalVolume* GetScoringVolume() const { return fScoringVolume; }
 
+    void SetRegionCut(const G4String& regionName, G4double cut);
+    void SetRegionStepMax(const G4String& regionName, G4double stepMax);
+
+    void SetDeadLayerThickness(G4double thickness);
+    void SetWindowThickness(G4double thickness);
+    void SetFramePosition(G4double z);
+    void SetShieldPosition(G4double z);
+    G4double GetDeadLayerThickness() const { return fDeadLayerThickness; }
+    G4double GetWindowThickness() const    { return fWindowThickness; }
+    G4double GetFramePosition() const      { return fFrameZ; }
+    G4double GetShieldPosition() const     { return fShieldZ; }
+
+    enum OverlapCheckMode { kOverlapAlways, kOverlapCached, kOverlapNever };
+    void SetOverlapCheckMode(OverlapCheckMode mode) { fOverlapCheckMode = mode; }
+    void SetOverlapCacheFile(const G4String& name) { fOverlapCacheFile = name; }
+
   protected:
     G4LogicalVolume*  fScoringVolume;
+
+  private:
+    void DefineRegion(const G4String& regionName, G4LogicalVolume* volume);
+    void ApplyRegionSettings(const G4String& regionName);
+    void UpdateGeometry();
+    void CheckOverlaps();
+    G4String GeometryHash() const;
+
+    B1DetectorMessenger*         fMessenger;
+    std::map<G4String, G4double> fRegionCuts;
+    std::map<G4String, G4double> fRegionStepMax;
+
+    // geometry parameters
+    G4double fDeadLayerThickness;
+    G4double fWindowThickness;
+    G4double fFrameZ;
+    G4double fShieldZ;
+    G4double fCrystalFrontZ;
+
+    // volumes modified by the parameters, 0 until Construct()
+    G4Cons*            fDeadLayerSolid;
+    G4VPhysicalVolume* fDeadLayerPV;
+    G4Cons*            fWindowSolid;
+    G4VPhysicalVolume* fWindowPV;
+    G4VPhysicalVolume* fFramePV;
+    G4VPhysicalVolume* fShieldPV;
+
+    OverlapCheckMode fOverlapCheckMode;
+    G4String         fOverlapCacheFile;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
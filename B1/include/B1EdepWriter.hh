@@ -0,0 +1,97 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1EdepWriter.hh
+/// \brief Definition of the B1EdepWriter class
+
+#ifndef B1EdepWriter_h
+#define B1EdepWriter_h 1
+
+#include "globals.hh"
+
+#include <cstddef>
+
+/// Per-thread binary writer for one per-event quantity, by default the
+/// energy deposit.
+///
+/// The data file is a flat array of float32 values (energies in keV),
+/// one record per event, in host byte order and with no header, so that
+/// it can be mapped directly (e.g. numpy.memmap(file, dtype='<f4') on x86).
+/// It is written through a shared memory mapping that is extended by
+/// fixed size pages.
+/// A small text manifest (<file>.json) gives the record type, byte order,
+/// unit, number of records and number of events processed, which differ
+/// when a trigger threshold is applied.
+
+class B1EdepWriter
+{
+  public:
+    B1EdepWriter();
+   ~B1EdepWriter();
+
+    G4bool Open(const G4String& fileName,
+                const G4String& column = "ESpec", const G4String& unit = "keV");
+    void   Close();
+
+    // does nothing if the file is not open
+    inline void Append(G4float value);
+
+    // total number of events, including those not written out
+    void SetNofEvents(std::size_t nofEvents) { fNofEvents = nofEvents; }
+
+    G4bool IsOpen() const { return fFd >= 0; }
+    std::size_t GetNofRecords() const { return fNofRecords; }
+    const G4String& GetFileName() const { return fFileName; }
+
+  private:
+    G4bool MapNextPage();
+    void   UnmapPage();
+    void   WriteManifest() const;
+
+    G4String    fFileName;
+    G4String    fColumn;
+    G4String    fUnit;
+    G4int       fFd;
+    G4float*    fPage;          // current mapped page
+    std::size_t fPageIndex;     // index of the current page in the file
+    std::size_t fPagePos;       // next record in the current page
+    std::size_t fPageRecords;   // records per page
+    std::size_t fNofRecords;
+    std::size_t fNofEvents;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void B1EdepWriter::Append(G4float value)
+{
+  if (fFd < 0) return;
+  if (fPagePos == fPageRecords && ! MapNextPage()) return;
+  fPage[fPagePos++] = value;
+  ++fNofRecords;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
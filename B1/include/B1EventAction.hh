@@ -34,26 +34,48 @@
 #include "globals.hh"
 
 class B1RunAction;
+class B1EventMessenger;
 class HistoManager;
+class B1Profiler;
+class B1HistoryTree;
+class B1EventInformation;
 
 /// Event action class
 ///
+/// In EndOfEventAction(), the energy deposit in the Ge crystal is summed
+/// from the hits collection of B1GeSD and passed to the run action.
+/// Only events with an energy deposit above the trigger threshold
+/// (/B1/score/threshold, 0 by default) are passed on to the histogram
+/// manager; the others are only counted, for the normalisation.
+/// Under importance sampling, the hits are also summed per history branch
+/// and each weighted alternative Edep of the event (B1HistoryTree, owned
+/// by the event action) is scored in the same way.
 
 class B1EventAction : public G4UserEventAction
 {
   public:
-    B1EventAction(B1RunAction* runAction, HistoManager*);
+    B1EventAction(B1RunAction* runAction, HistoManager*, B1Profiler*,
+                  B1HistoryTree*);
     virtual ~B1EventAction();
 
     virtual void BeginOfEventAction(const G4Event* event);
     virtual void EndOfEventAction(const G4Event* event);
 
-    void AddEdep(G4double edep) { fEdep += edep; }
+    void SetThreshold(G4double threshold) { fThreshold = threshold; }
 
   private:
+    // score one Edep of the event; return true if triggered
+    G4bool Score(const B1EventInformation* info, G4double edep,
+                 G4double weight, G4bool newEvent);
+
     B1RunAction* fRunAction;
     HistoManager* fHistoManager;
+    B1Profiler*  fProfiler;
+    B1HistoryTree* fHistory;
+    B1EventMessenger* fMessenger;
     G4double     fEdep;
+    G4double     fThreshold;
+    G4int        fGeHCID;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
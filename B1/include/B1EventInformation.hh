@@ -0,0 +1,62 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1EventInformation.hh
+/// \brief Definition of the B1EventInformation class
+
+#ifndef B1EventInformation_h
+#define B1EventInformation_h 1
+
+#include "G4VUserEventInformation.hh"
+#include "globals.hh"
+
+/// Event information class
+///
+/// Carries the index of the scan point (B1ScanGrid) the source of the
+/// event was placed at, from the primary generator to the event action
+/// (-1 without a scan), and the product of the weights of the biased
+/// decays of the event (B1BiasedDecay).
+
+class B1EventInformation : public G4VUserEventInformation
+{
+  public:
+    B1EventInformation(G4int point = -1);
+    virtual ~B1EventInformation();
+
+    // method from the base class
+    virtual void Print() const;
+
+    G4int    GetPoint() const       { return fPoint; }
+    G4double GetDecayWeight() const { return fDecayWeight; }
+    void MultiplyDecayWeight(G4double weight) { fDecayWeight *= weight; }
+
+  private:
+    G4int    fPoint;
+    G4double fDecayWeight;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
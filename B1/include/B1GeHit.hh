@@ -0,0 +1,111 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1GeHit.hh
+/// \brief Definition of the B1GeHit class
+
+#ifndef B1GeHit_h
+#define B1GeHit_h 1
+
+#include "G4VHit.hh"
+#include "G4THitsCollection.hh"
+#include "G4Allocator.hh"
+#include "G4ThreeVector.hh"
+#include "tls.hh"
+
+/// Ge crystal hit class
+///
+/// It defines data members to store the energy deposit of a single step
+/// in the Ge crystal, with its position, global time, track ID and
+/// track weight, and the history branch of the track under importance
+/// sampling (B1HistoryTree):
+/// - fTrackID, fEdep, fTime, fPos, fWeight, fBranch
+
+class B1GeHit : public G4VHit
+{
+  public:
+    B1GeHit();
+    B1GeHit(const B1GeHit&);
+    virtual ~B1GeHit();
+
+    // operators
+    const B1GeHit& operator=(const B1GeHit&);
+    G4bool operator==(const B1GeHit&) const;
+
+    inline void* operator new(size_t);
+    inline void  operator delete(void*);
+
+    // methods from base class
+    virtual void Print();
+
+    // Set methods
+    void SetTrackID(G4int track)       { fTrackID = track; }
+    void SetEdep(G4double de)          { fEdep = de; }
+    void SetTime(G4double t)           { fTime = t; }
+    void SetPos(const G4ThreeVector& xyz) { fPos = xyz; }
+    void SetWeight(G4double w)         { fWeight = w; }
+    void SetBranch(G4int branch)       { fBranch = branch; }
+
+    // Get methods
+    G4int GetTrackID() const           { return fTrackID; }
+    G4double GetEdep() const           { return fEdep; }
+    G4double GetTime() const           { return fTime; }
+    const G4ThreeVector& GetPos() const { return fPos; }
+    G4double GetWeight() const         { return fWeight; }
+    G4int GetBranch() const            { return fBranch; }
+
+  private:
+    G4int         fTrackID;
+    G4double      fEdep;
+    G4double      fTime;
+    G4ThreeVector fPos;
+    G4double      fWeight;
+    G4int         fBranch;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+typedef G4THitsCollection<B1GeHit> B1GeHitsCollection;
+
+extern G4ThreadLocal G4Allocator<B1GeHit>* B1GeHitAllocator;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void* B1GeHit::operator new(size_t)
+{
+  if(!B1GeHitAllocator) B1GeHitAllocator = new G4Allocator<B1GeHit>;
+  return (void *) B1GeHitAllocator->MallocSingle();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void B1GeHit::operator delete(void *hit)
+{
+  B1GeHitAllocator->FreeSingle((B1GeHit*) hit);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
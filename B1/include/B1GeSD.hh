@@ -0,0 +1,66 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1GeSD.hh
+/// \brief Definition of the B1GeSD class
+
+#ifndef B1GeSD_h
+#define B1GeSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+
+#include "B1GeHit.hh"
+
+class G4Step;
+class G4HCofThisEvent;
+
+/// Ge crystal sensitive detector class
+///
+/// In Initialize(), it creates one hits collection per event, with room
+/// for fReservedHits hits, so that the collection does not reallocate
+/// in the common case.
+/// The hit is created in ProcessHits() for every step with a non zero
+/// energy deposit in the crystal.
+
+class B1GeSD : public G4VSensitiveDetector
+{
+  public:
+    B1GeSD(const G4String& name, 
+           const G4String& hitsCollectionName);
+    virtual ~B1GeSD();
+  
+    // methods from base class
+    virtual void   Initialize(G4HCofThisEvent* hitCollection);
+    virtual G4bool ProcessHits(G4Step* step, G4TouchableHistory* history);
+
+  private:
+    B1GeHitsCollection* fHitsCollection;
+    G4int               fHCID;
+    std::size_t         fReservedHits;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -5,11 +5,59 @@
 
 #include "g4root.hh"
 
+#include "B1ResolutionFolder.hh"
+#include "B1SparseSpectra.hh"
+
+#include <algorithm>
+#include <vector>
+
+class HistoMessenger;
+class B1EdepWriter;
+class B1RunSummary;
+class B1ScanGrid;
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+/// One instance per thread. The "ESpec" spectrum is accumulated in a
+/// plain per-thread bin array and copied into the booked H1 once, in
+/// Save() at end of run. The ntuple rows are buffered per thread and
+/// flushed at end of run (or every 2^20 rows); the flush still fills them
+/// one row at a time, as G4AnalysisManager has no block fill, so the
+/// buffer only takes the ntuple calls out of the event loop.
+///
+/// The per-event Edep goes either to the "B1" ntuple of the ROOT file
+/// (merged on the master), or, with /B1/output/format binary, to one
+/// B1EdepWriter file per thread, which is never merged.
+/// Event weights go to the "Weight" ntuple column; in binary mode a
+/// parallel weight file is only written once a weight differs from 1.
+/// With /B1/output/format none, no per-event output is written at all.
+///
+/// With /B1/resolution/mode event, the triggered events are also
+/// broadened with the Ge resolution (B1ResolutionFolder) at end of event
+/// into a second spectrum, "ESpecFolded" (id 1).
+///
+/// With /B1/output/summaryFile, the master also writes the spectra with
+/// the run totals to a B1RunSummary file, for merging sharded runs.
+///
+/// In a source position scan (B1ScanGrid), the Edep of the triggered
+/// events is also scored per scan point in a per-thread table with the
+/// binning of "ESpec", handed over at end of run to the H2 "ESpecScan"
+/// (x: point index, y: Edep), with the number of events per point in the
+/// H1 "ScanEvents". To keep the table small it holds no energy moments:
+/// the y statistics of "ESpecScan" use the bin centres.
+///
+/// Further spectra of the triggered events are defined with /B1/histo/:
+/// H1s with their own range and linear or logarithmic binning
+/// (addSpectrum), kept in per-thread buffers like "ESpec", and sparse
+/// fine-binned spectra (addSparse, B1SparseSpectra) written to text files
+/// by the master. All are filled from the same Edep by FillSpectra().
+
 class HistoManager
 {
   public:
+    enum OutputFormat { kRoot, kBinary, kNone };
+    enum FoldingMode { kFoldOff, kFoldEvent };
+
     HistoManager();
    ~HistoManager();
 
@@ -18,12 +66,165 @@ class HistoManager
     
     void FillHisto(G4int id, G4double e, G4double weight = 1.0);
    
-    void FillNtuple(G4double engery);
+    void FillNtuple(G4double engery, G4double weight = 1.0);
+
+    // fill the spectra defined with /B1/histo/
+    inline void FillSpectra(G4double energy, G4double weight = 1.0);
+
+    // fill "ESpecFolded" with the energy broadened by the resolution
+    void FillFolded(G4double energy, G4double weight = 1.0);
+
+    // score an event of scan point "point", histogrammed if triggered;
+    // newEvent false: another weighted Edep of the same event
+    inline void FillScan(G4int point, G4double energy, G4double weight,
+                         G4bool triggered, G4bool newEvent = true);
+    // master: print the detection efficiency per scan point
+    void PrintScan();
+
+    // number of events processed by this thread, for the normalisation
+    void SetNofEvents(G4int nofEvents) { fNofEvents = nofEvents; }
+
+    // add the spectra to the run summary; call before Save()
+    void FillSummary(B1RunSummary& summary);
+
+    void SetFileName(const G4String& name) { fFileName = name; }
+    const G4String& GetFileName() const { return fFileName; }
+    void SetSummaryFileName(const G4String& name) { fSummaryFileName = name; }
+    const G4String& GetSummaryFileName() const { return fSummaryFileName; }
+    void SetOutputFormat(OutputFormat format) { fOutputFormat = format; }
+    void SetFoldingMode(FoldingMode mode) { fFoldingMode = mode; }
+    B1ResolutionFolder& GetResolutionFolder() { return fFolder; }
+    void SetScanGrid(B1ScanGrid* grid) { fScanGrid = grid; }
+
+    // spectra definitions, from the next run on
+    void AddSpectrum(const G4String& name, G4int nbins,
+                     G4double emin, G4double emax, G4bool logBins);
+    void AddSparseSpectrum(const G4String& name, G4double binWidth,
+                           G4double emin, G4double emax);
+    void ClearSpectra();
+    B1SparseSpectra* GetSparseSpectra() { return &fSparseSpectra; }
+
   private:
+    // bin content with the same statistics as tools::histo::h1d
+    struct BinData {
+      unsigned int fEntries;
+      G4double     fSw, fSw2, fSxw, fSx2w;
+    };
+
+    // spectrum defined with /B1/histo/addSpectrum; the log bin edges are
+    // taken from the booked H1, so that the bins match its axis exactly
+    struct Spectrum {
+      G4String fName;
+      G4int    fNbins;
+      G4double fEmin, fEmax;
+      G4bool   fLog;
+      G4double fInvBinWidth;
+      G4int    fH1Id;
+      std::vector<G4double> fEdges;
+      std::vector<BinData>  fBins;
+    };
+
+    // scan table cell
+    struct ScanBin {
+      unsigned int fEntries;
+      G4double     fSw, fSw2;
+    };
+
+    void ReduceHisto();
+    void CopyBins(G4int id, const std::vector<BinData>& bins);
+    void ReduceScan();
+    void FlushNtuple();
+
     G4bool fFactoryOn;    
+
+    HistoMessenger* fMessenger;
+    G4String        fFileName;
+    G4String        fSummaryFileName;
+    OutputFormat    fOutputFormat;
+    B1EdepWriter*   fEdepWriter;
+    B1EdepWriter*   fWeightWriter;
+    G4int           fNofEvents;
+
+    // "ESpec" and "ESpecFolded" binning and contents, per histogram id;
+    // index 0 is the underflow and fNbins+1 the overflow, as in tools::histo
+    G4int    fNbins;
+    G4double fEmin;
+    G4double fEmax;
+    G4double fInvBinWidth;
+    std::vector<std::vector<BinData> > fBins;
+
+    // spectra defined with /B1/histo/
+    std::vector<Spectrum> fSpectra;
+    B1SparseSpectra       fSparseSpectra;
+
+    // resolution folding
+    FoldingMode           fFoldingMode;
+    B1ResolutionFolder    fFolder;
+
+    // source position scan, fNbins+2 cells per point
+    B1ScanGrid*                fScanGrid;
+    G4int                      fScanH2Id;
+    G4int                      fScanEventsId;
+    std::vector<ScanBin>       fScanBins;
+    std::vector<unsigned int>  fScanEvents;
+
+    // ntuple row buffer, one vector per column
+    std::vector<G4double> fNtupleESpec;
+    std::vector<G4double> fNtupleWeight;
+    std::size_t           fNtupleFlushSize;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+inline void HistoManager::FillSpectra(G4double e, G4double weight)
+{
+  for (std::size_t is = 0; is < fSpectra.size(); ++is) {
+    Spectrum& spectrum = fSpectra[is];
+    if (spectrum.fH1Id < 0) continue;
+
+    G4int i;
+    if (e < spectrum.fEmin)       i = 0;
+    else if (e >= spectrum.fEmax) i = spectrum.fNbins + 1;
+    else if (spectrum.fLog) {
+      i = std::upper_bound(spectrum.fEdges.begin(), spectrum.fEdges.end(), e)
+          - spectrum.fEdges.begin();
+    }
+    else i = 1 + G4int((e - spectrum.fEmin)*spectrum.fInvBinWidth);
+    if (i > spectrum.fNbins + 1) i = spectrum.fNbins + 1;
+
+    BinData& bin = spectrum.fBins[i];
+    bin.fEntries++;
+    bin.fSw   += weight;
+    bin.fSw2  += weight*weight;
+    bin.fSxw  += e*weight;
+    bin.fSx2w += e*e*weight;
+  }
+  fSparseSpectra.Fill(e, weight);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void HistoManager::FillScan(G4int point, G4double e, G4double weight,
+                                   G4bool triggered, G4bool newEvent)
+{
+  if (fScanH2Id < 0 || point < 0 || point >= G4int(fScanEvents.size())) return;
+
+  if (newEvent) fScanEvents[point]++;
+  if (! triggered) return;
+
+  G4int i;
+  if (e < fEmin)       i = 0;
+  else if (e >= fEmax) i = fNbins + 1;
+  else                 i = 1 + G4int((e - fEmin)*fInvBinWidth);
+  if (i > fNbins + 1) i = fNbins + 1;
+
+  ScanBin& bin = fScanBins[std::size_t(point)*(fNbins + 2) + i];
+  bin.fEntries++;
+  bin.fSw  += weight;
+  bin.fSw2 += weight*weight;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 #endif
 
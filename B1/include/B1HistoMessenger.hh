@@ -0,0 +1,81 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1HistoMessenger.hh
+/// \brief Definition of the HistoMessenger class
+
+#ifndef HistoMessenger_h
+#define HistoMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class HistoManager;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithoutParameter;
+class G4UIcmdWithAString;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Messenger for the output of HistoManager (/B1/output/ directory)
+/// and its resolution folding (/B1/resolution/ directory) and spectra
+/// definitions (/B1/histo/ directory)
+
+class HistoMessenger: public G4UImessenger
+{
+  public:
+    HistoMessenger(HistoManager*);
+   ~HistoMessenger();
+
+    virtual void SetNewValue(G4UIcommand*, G4String);
+    virtual G4String GetCurrentValue(G4UIcommand*);
+
+  private:
+    HistoManager*       fHistoManager;
+
+    G4UIdirectory*      fB1Dir;
+    G4UIdirectory*      fOutputDir;
+    G4UIcmdWithAString* fFileNameCmd;
+    G4UIcmdWithAString* fFormatCmd;
+    G4UIcmdWithAString* fSummaryCmd;
+
+    G4UIdirectory*             fResolutionDir;
+    G4UIcmdWithAString*        fFoldModeCmd;
+    G4UIcmdWithADouble*        fFanoCmd;
+    G4UIcmdWithADoubleAndUnit* fPairEnergyCmd;
+    G4UIcmdWithADoubleAndUnit* fNoiseCmd;
+
+    G4UIdirectory*             fHistoDir;
+    G4UIcommand*               fSpectrumCmd;
+    G4UIcommand*               fSparseCmd;
+    G4UIcmdWithoutParameter*   fClearCmd;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,120 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1HistoryTree.hh
+/// \brief Definition of the B1HistoryTree class
+
+#ifndef B1HistoryTree_h
+#define B1HistoryTree_h 1
+
+#include "globals.hh"
+
+#include <utility>
+#include <vector>
+
+class B1ImportanceMap;
+
+/// Splitting and Russian roulette of one event, for the pulse height
+/// spectrum under importance sampling.
+///
+/// The Edep of an event is a sum over all its tracks, so the copies of a
+/// split track cannot simply share its weight, as they would for a
+/// dose: they are alternative continuations of the same history. Each
+/// split or roulette opens a node below the branch of the track, with one
+/// branch per copy (or one for the roulette survivor), and the hits are
+/// summed per branch. At end of event, the tree is resolved into a set of
+/// weighted alternative values of the Edep, whose weights sum to 1:
+/// - a branch is its own Edep plus that of each node below it, as a sum
+///   of independent contributions (all combinations);
+/// - a split node in n copies is the mixture of its branches, weight 1/n;
+/// - a roulette node, survival probability p, is its branch with weight
+///   1/p, plus Edep 0 with weight 1 - 1/p (a rouletted track is removed
+///   from the history, and a killed one is simply not recorded).
+/// Filling all the alternatives gives an unbiased spectrum. Equal values
+/// are merged, so that the subtrees which never reach the crystal, the
+/// most frequent case, collapse to a single Edep 0 of weight 1.
+///
+/// Independent nodes multiply the number of alternatives. When a
+/// combination would exceed /B1/importance/maxAlternatives, the node
+/// mixture is replaced by one of its values, drawn with probability
+/// |weight|/sum|weight| and given the weight sign*sum|weight|: for a split
+/// node, one copy chosen uniformly with weight 1. Its expectation is the
+/// node mixture, so the spectra stay unbiased, at the cost of variance.
+///
+/// One instance per thread, shared by the stepping and event actions.
+
+class B1HistoryTree
+{
+  public:
+    B1HistoryTree(const B1ImportanceMap* map);
+   ~B1HistoryTree();
+
+    // start of event: only the root branch 0
+    void Reset();
+
+    G4int GetNofNodes() const { return fNodes.size(); }
+
+    // new node below "branch"; return the first of its branches, the
+    // others follow
+    G4int Split(G4int branch, G4int nofCopies);
+    G4int Survive(G4int branch, G4double probability);
+
+    void AddEdep(G4int branch, G4double edep);
+
+    // end of event: the alternative values of the Edep
+    void Resolve();
+    std::size_t GetNofAlternatives() const { return fAlternatives.size(); }
+    G4double GetEdep(std::size_t i) const   { return fAlternatives[i].first; }
+    G4double GetWeight(std::size_t i) const { return fAlternatives[i].second; }
+
+  private:
+    // (Edep, weight) pairs
+    typedef std::vector<std::pair<G4double, G4double> > Mixture;
+
+    struct Node {
+      G4int    fParent;       // branch
+      G4int    fFirstBranch;
+      G4int    fNofBranches;
+      G4double fSurvival;     // roulette survival probability, 1 for a split
+    };
+
+    G4int NewNode(G4int branch, G4int nofBranches, G4double survival);
+    void  BranchMixture(G4int branch, Mixture& mixture) const;
+    void  NodeMixture(const Node& node, Mixture& mixture) const;
+    static void Convolve(Mixture& mixture, const Mixture& other);
+    static void Compact(Mixture& mixture);
+    static void Sample(Mixture& mixture);
+
+    const B1ImportanceMap*          fMap;
+
+    std::vector<Node>               fNodes;
+    std::vector<G4double>           fBranchEdep;
+    std::vector<std::vector<G4int> > fBranchNodes;  // nodes below each branch
+    Mixture                         fAlternatives;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,92 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1ImportanceMap.hh
+/// \brief Definition of the B1ImportanceMap class
+
+#ifndef B1ImportanceMap_h
+#define B1ImportanceMap_h 1
+
+#include "globals.hh"
+
+#include <map>
+
+class B1ImportanceMessenger;
+class G4VPhysicalVolume;
+
+/// Importance of the physical volumes, by name, for the splitting and
+/// Russian roulette of B1SteppingAction (/B1/importance/ directory).
+///
+/// A track carries the importance its population corresponds to
+/// (B1TrackInformation). When it enters a volume of higher importance
+/// moving towards the Ge crystal, it is split in about the ratio of the
+/// two; when it enters a volume of lower importance moving away from the
+/// crystal, it survives the roulette with the ratio as probability. The
+/// other crossings leave it unchanged, so that a track crossing the air
+/// gap between the window and the crystal is not rouletted on its way in.
+/// The copies of a split are limited to /B1/importance/maxSplit; ions are
+/// never split. The event weights are handled by B1HistoryTree, which
+/// scores at most /B1/importance/maxAlternatives weighted Edep values per
+/// event.
+///
+/// The defaults favour the crystal and the window, and roulette the
+/// tracks leaving the Envelope; volumes not listed have importance 1.
+///
+/// The stepping action of each thread resolves the names to the physical
+/// volumes at the start of each run, so GetImportance() is not called
+/// per step.
+///
+/// One instance is shared by all threads; it is only changed between runs.
+
+class B1ImportanceMap
+{
+  public:
+    B1ImportanceMap();
+   ~B1ImportanceMap();
+
+    void SetEnabled(G4bool flag) { fEnabled = flag; }
+    void SetImportance(const G4String& volume, G4double importance);
+    void SetMaxSplit(G4int maxSplit) { fMaxSplit = maxSplit; }
+    void SetMaxAlternatives(G4int n) { fMaxAlternatives = n; }
+
+    G4bool   IsActive() const { return fEnabled; }
+    G4double GetImportance(const G4VPhysicalVolume* volume) const;
+    G4int    GetMaxSplit() const { return fMaxSplit; }
+    G4int    GetMaxAlternatives() const { return fMaxAlternatives; }
+
+    void Print() const;
+
+  private:
+    B1ImportanceMessenger* fMessenger;
+
+    G4bool   fEnabled;
+    G4int    fMaxSplit;
+    G4int    fMaxAlternatives;
+    std::map<G4String, G4double> fImportance;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
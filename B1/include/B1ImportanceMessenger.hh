@@ -0,0 +1,69 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1ImportanceMessenger.hh
+/// \brief Definition of the B1ImportanceMessenger class
+
+#ifndef B1ImportanceMessenger_h
+#define B1ImportanceMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class B1ImportanceMap;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithABool;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithoutParameter;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Messenger for the importance sampling (/B1/importance/ directory).
+/// The importance map is shared by all threads, the commands are not
+/// broadcast.
+
+class B1ImportanceMessenger: public G4UImessenger
+{
+  public:
+    B1ImportanceMessenger(B1ImportanceMap*);
+   ~B1ImportanceMessenger();
+
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    B1ImportanceMap*         fMap;
+
+    G4UIdirectory*           fImportanceDir;
+    G4UIcmdWithABool*        fEnableCmd;
+    G4UIcommand*             fVolumeCmd;
+    G4UIcmdWithAnInteger*    fMaxSplitCmd;
+    G4UIcmdWithAnInteger*    fMaxAlternativesCmd;
+    G4UIcmdWithoutParameter* fPrintCmd;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,58 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1LowEnergyEmPhysics.hh
+/// \brief Definition of the B1LowEnergyEmPhysics class
+
+#ifndef B1LowEnergyEmPhysics_h
+#define B1LowEnergyEmPhysics_h 1
+
+#include "G4VPhysicsConstructor.hh"
+#include "globals.hh"
+
+/// Minimal electromagnetic constructor for photon spectroscopy below
+/// ~1 MeV in Ge, C, Al and air.
+///
+/// Only gamma, e- and e+ (plus the geantinos used by the primary
+/// generator, and the proton for the production cuts table) are built.
+/// Photons get the Livermore photo-electric, Compton and Rayleigh models,
+/// electrons Urban multiple scattering, Livermore ionisation and
+/// Seltzer-Berger bremsstrahlung. Positrons are not produced in this
+/// energy range and only get transportation.
+/// The tables span 100 eV - 1 MeV, with fluorescence on.
+
+class B1LowEnergyEmPhysics : public G4VPhysicsConstructor
+{
+  public:
+    B1LowEnergyEmPhysics(G4int verbose = 1);
+    virtual ~B1LowEnergyEmPhysics();
+
+    virtual void ConstructParticle();
+    virtual void ConstructProcess();
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
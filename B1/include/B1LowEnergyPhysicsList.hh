@@ -0,0 +1,27 @@
+
+#ifndef LowEnergyPhysicsList_h
+#define LowEnergyPhysicsList_h 1
+
+//#ifndef与#endif防止头文件的重复包含和编译
+
+#include "G4VModularPhysicsList.hh"
+
+class B1PhysicsTableCache;
+
+//低能光子能谱专用的精简物理列表：只有gamma、e-、e+与低能电磁过程，
+//没有放射性衰变与离子物理，须与/B1/gun/mode lines一起使用。
+//启动时以环境变量B1_PHYSLIST=lowenergy选择（见exampleB1.cc）
+
+class LowEnergyPhysicsList: public G4VModularPhysicsList
+{
+public:
+LowEnergyPhysicsList();
+virtual ~LowEnergyPhysicsList();
+
+virtual void SetCuts();
+
+private:
+B1PhysicsTableCache* fTableCache;//物理表的磁盘缓存
+};
+
+#endif //#ifndef与#endif防止头文件的重复包含和编译
@@ -5,6 +5,9 @@
 
 #include "G4VModularPhysicsList.hh"//一般用户自定义的PhysicsList类继承于此
 
+class PhysicsListMessenger;
+class B1PhysicsTableCache;
+
 class PhysicsList: public G4VModularPhysicsList
 //一般用户自定义的PhysicsList类继承于G4VModularPhysicsList
 {
@@ -12,7 +15,20 @@ public:
 PhysicsList();//构造函数声明，将在对应源文件中定义
 virtual ~PhysicsList();//析构函数声明，将在对应源文件中定义
 
+virtual void ConstructProcess();//构建物理过程，可选地包装放射性衰变过程
 virtual void SetCuts();//成员函数SetCuts()声明,将在对应源文件中定义
+
+//放射性衰变光子的几何偏倚（见B1BiasedDecay），须在/run/initialize之前设置
+void SetDecayBiasing(G4bool flag) { fDecayBiasing = flag; }
+void SetConeProbability(G4double prob) { fConeProbability = prob; }
+
+private:
+void WrapRadioactiveDecay();//用B1BiasedDecay替换GenericIon的放射性衰变过程
+
+PhysicsListMessenger* fMessenger;
+B1PhysicsTableCache* fTableCache;//物理表的磁盘缓存
+G4bool   fDecayBiasing;
+G4double fConeProbability;
 };
 
-#endif //#ifndef与#endif防止头文件的重复包含和编译
\ No newline at end of file
+#endif //#ifndef与#endif防止头文件的重复包含和编译
@@ -0,0 +1,88 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1PhysicsTableCache.hh
+/// \brief Definition of the B1PhysicsTableCache class
+
+#ifndef B1PhysicsTableCache_h
+#define B1PhysicsTableCache_h 1
+
+#include "G4VStateDependent.hh"
+#include "globals.hh"
+
+class G4VModularPhysicsList;
+
+/// On-disk cache of the physics tables of a modular physics list.
+///
+/// The tables are stored in <cache dir>/<key>/ with
+/// G4VUserPhysicsList::StorePhysicsTable(), where the key is a hash of
+/// the registered constructors, the EM parameters, the default cut, the
+/// production cuts of every region, the material and region of every
+/// volume, the materials (name, density, composition), the data set paths
+/// and the Geant4 version.
+///
+/// The cache follows the state changes of the master thread: when an
+/// initialisation starts (Idle -> Init), a complete entry for the current
+/// key is requested with SetPhysicsTableRetrieved(), and retrieval is
+/// switched off again when it is over (Init -> Idle). The tables are only
+/// built by the run initialisation, which then closes the geometry
+/// (Idle -> GeomClosed): the tables of a new key are stored there, under
+/// the key computed at that time. A plain /run/initialize goes through
+/// Init -> Idle too, but without building the tables, and stores nothing.
+/// Only the processes implementing StorePhysicsTable() (the EM processes)
+/// are cached, the others are rebuilt as usual.
+///
+/// The cache directory is B1PhysicsTables, or the value of the environment
+/// variable B1_PHYSICS_CACHE; "none" disables the cache. Concurrent jobs
+/// are safe: each job stores the tables in a directory of its own
+/// (<key>.tmp<pid>), which is renamed to the entry once complete, so an
+/// entry is never seen partially written; the first rename wins. An
+/// entry without its "complete" marker, left by an older version, is
+/// replaced by the next store.
+
+class B1PhysicsTableCache : public G4VStateDependent
+{
+  public:
+    B1PhysicsTableCache(G4VModularPhysicsList* physicsList);
+    virtual ~B1PhysicsTableCache();
+
+    // method from the base class
+    virtual G4bool Notify(G4ApplicationState requestedState);
+
+  private:
+    G4String Key() const;
+    void     Store(const G4String& key);
+    static void RemoveDirectory(const G4String& dir);
+
+    G4VModularPhysicsList* fPhysicsList;
+    G4String               fCacheDir;
+    G4String               fTableKey;     // key of the tables in memory
+    G4String               fRetrievedKey; // key of the entry requested
+    G4bool                 fInitialised;  // Init -> Idle was the last change
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -34,19 +34,51 @@
 #include "G4ParticleGun.hh"
 #include "globals.hh"
 
+#include "B1AliasTable.hh"
+
+#include <vector>
+
 class G4ParticleGun;
+class G4ParticleDefinition;
 class G4Event;
 class G4Box;
+class B1PrimaryGeneratorMessenger;
+class B1Profiler;
+class B1ScanGrid;
 
 /// The primary generator action class with particle gun.
 ///
-/// The default kinematic is a 6 MeV gamma, randomly distribued 
-/// in front of the phantom across 80% of the (X,Y) phantom size.
+/// The default source (/B1/gun/mode ion) is a Co-57 ion at rest at
+/// (0,0,-0.2 cm), which is then decayed by G4RadioactiveDecay.
+///
+/// With /B1/gun/mode lines, each event is a single photon or electron
+/// drawn from a tabulated Co-57 emission line list, with an alias table,
+/// and emitted isotropically from the same point. The event is weighted
+/// by the total number of emissions per decay, so that the spectra are
+/// normalised per decay, as with the ion source. Coincidences between
+/// the emissions of one decay are not simulated.
+///
+/// With /B1/random/eventSeeds <runSeed>, the random engine is reseeded at
+/// the start of each event from (runSeed, event number) only, so that an
+/// event history does not depend on the thread or task layout and any
+/// range of events can be recomputed on its own. The event number is the
+/// event ID plus /B1/random/firstEvent, the offset of a shard or of a
+/// replayed range. The offset advances by the number of events of each
+/// run (AdvanceFirstEvent(), from B1RunAction), so that the successive
+/// runs of a macro get new event numbers instead of replaying the first.
+///
+/// With /B1/scan/enable, the source of each event is placed on a point of
+/// the scan grid (B1ScanGrid) chosen by the event number, and the point
+/// index is attached to the event as a B1EventInformation. With
+/// /B1/scan/adaptive, the point is taken from batches handed out by the
+/// scan scheduler instead, and then depends on the thread layout: the
+/// per-event seeding no longer makes the events reproducible, which is
+/// warned about at the first batch of each run.
 
 class B1PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
   public:
-    B1PrimaryGeneratorAction();    
+    B1PrimaryGeneratorAction(B1Profiler* profiler = 0, B1ScanGrid* grid = 0);
     virtual ~B1PrimaryGeneratorAction();
 
     // method from the base class
@@ -54,10 +86,45 @@ class B1PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
   
     // method to access particle gun
     const G4ParticleGun* GetParticleGun() const { return fParticleGun; }
+
+    enum SourceMode { kIon, kLines };
+    void SetSourceMode(SourceMode mode);
+
+    // per-event seeding, off with runSeed 0
+    void SetEventSeeding(G4long runSeed) { fRunSeed = runSeed; }
+    void SetFirstEvent(G4long firstEvent) { fFirstEvent = firstEvent; }
+    // end of run: the next run continues the event numbers
+    void AdvanceFirstEvent(G4long nofEvents) { fFirstEvent += nofEvents; }
   
   private:
+    void BuildLineTable();
+    void GenerateLine(G4Event*);
+    void SeedEvent(G4long eventNumber);
+    void PlaceSource(G4Event*);
+
     G4ParticleGun*  fParticleGun; // pointer a to G4 gun class
     G4Box* fEnvelopeBox;
+
+    B1PrimaryGeneratorMessenger* fMessenger;
+    B1Profiler* fProfiler;
+    B1ScanGrid* fScanGrid;
+    SourceMode fSourceMode;
+    G4long fRunSeed;
+    G4long fFirstEvent;
+
+    // source position outside of the scans
+    G4ThreeVector fDefaultPosition;
+    G4bool        fScanning;
+
+    // current batch of the adaptive scan
+    G4int fBatchPoint;
+    G4int fBatchLeft;
+    G4int fBatchRun;
+
+    // Co-57 emission lines
+    std::vector<G4ParticleDefinition*> fLineParticle;
+    std::vector<G4double>              fLineEnergy;
+    B1AliasTable                       fLineTable;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
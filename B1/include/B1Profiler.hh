@@ -0,0 +1,176 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1Profiler.hh
+/// \brief Definition of the B1Profiler class
+
+#ifndef B1Profiler_h
+#define B1Profiler_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <chrono>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <ostream>
+
+class B1ProfilerMessenger;
+class G4Step;
+class G4VPhysicalVolume;
+class G4ParticleDefinition;
+class G4VProcess;
+
+/// Per-thread timing of the simulation, switched on with
+/// /B1/profile/enable (off by default).
+///
+/// Events are split in phases, each closed by Mark():
+///  - generation : GeneratePrimaries() up to BeginOfEventAction()
+///  - tracking   : BeginOfEventAction() up to EndOfEventAction()
+///  - scoring    : hits summing and trigger in EndOfEventAction()
+///  - fill       : histogram and ntuple filling
+/// The tracking time is further split per step, by the volume in which
+/// the step starts, the particle type and the process limiting the step.
+/// A step is charged with the time since the previous step (or since
+/// the start of its track), measured in the stepping action. The step
+/// timing can be switched off (/B1/profile/steps false) to keep the
+/// overhead to a few clock reads per event.
+/// The event times, from StartEvent() to EndEvent(), are also histogrammed
+/// on a log scale (20 bins per decade from 0.1 us to 100 s) for the
+/// percentiles of the report.
+///
+/// The counters are kept per thread, keyed by pointer, then folded into
+/// tables keyed by name at the end of the run, and merged on the master
+/// as a G4VAccumulable with the other accumulables of B1RunAction.
+/// The master prints the tables and writes them as JSON to
+/// /B1/profile/fileName. The times are wall-clock seconds (steady_clock)
+/// of each thread, summed over threads.
+
+class B1Profiler : public G4VAccumulable
+{
+  public:
+    typedef std::chrono::steady_clock Clock;
+
+    enum Phase { kGeneration, kTracking, kScoring, kFill, kNofPhases };
+
+    B1Profiler();
+    virtual ~B1Profiler();
+
+    // methods from the base class
+    virtual void Merge(const G4VAccumulable& other);
+    virtual void Reset();
+
+    void SetEnabled(G4bool flag) { fEnabled = flag; }
+    G4bool IsEnabled() const { return fEnabled; }
+    void SetStepTiming(G4bool flag) { fStepTiming = flag; }
+    G4bool IsStepTimingEnabled() const { return fEnabled && fStepTiming; }
+    void SetFileName(const G4String& name) { fFileName = name; }
+
+    // event phases
+    inline void StartEvent();
+    inline void Mark(Phase phase);
+    void EndEvent();
+
+    // steps
+    inline void StartTrack();
+    void AddStep(const G4Step* step);
+
+    // end of run: fold on each thread before merging, report on master
+    void Fold();
+    void Report() const;
+
+    // event time percentile (0 < fraction < 1), in seconds
+    G4double GetEventTimePercentile(G4double fraction) const;
+
+  private:
+    struct Counter {
+      Counter() : fCount(0), fTime(0.) {}
+      G4long   fCount;
+      G4double fTime;  // seconds
+    };
+    typedef std::map<G4String, Counter> Table;
+
+    static void MergeTable(Table& to, const Table& from);
+    void PrintTable(std::ostream& os, const G4String& title,
+                    const Table& table, G4double totalTime) const;
+    void WriteTable(std::ostream& os, const G4String& title,
+                    const Table& table) const;
+
+    B1ProfilerMessenger* fMessenger;
+    G4bool               fEnabled;
+    G4bool               fStepTiming;
+    G4String             fFileName;
+
+    Clock::time_point    fEventStart;
+    Clock::time_point    fEventStamp;
+    Clock::time_point    fStepStamp;
+
+    // hot-path counters of this thread
+    std::unordered_map<const G4VPhysicalVolume*, Counter>    fVolumeCounters;
+    std::unordered_map<const G4ParticleDefinition*, Counter> fParticleCounters;
+    std::unordered_map<const G4VProcess*, Counter>           fProcessCounters;
+
+    // merged tables
+    Table    fVolumes;
+    Table    fParticles;
+    Table    fProcesses;
+    Counter  fPhases[kNofPhases];
+    G4long   fNofEvents;
+    std::vector<G4long> fEventTimeBins;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void B1Profiler::StartEvent()
+{
+  if ( ! fEnabled ) return;
+  fEventStart = Clock::now();
+  fEventStamp = fEventStart;
+  ++fNofEvents;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void B1Profiler::Mark(Phase phase)
+{
+  if ( ! fEnabled ) return;
+  Clock::time_point now = Clock::now();
+  fPhases[phase].fCount += 1;
+  fPhases[phase].fTime += std::chrono::duration<G4double>(now - fEventStamp).count();
+  fEventStamp = now;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void B1Profiler::StartTrack()
+{
+  if ( ! IsStepTimingEnabled() ) return;
+  fStepStamp = Clock::now();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
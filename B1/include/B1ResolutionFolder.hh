@@ -0,0 +1,67 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1ResolutionFolder.hh
+/// \brief Definition of the B1ResolutionFolder class
+
+#ifndef B1ResolutionFolder_h
+#define B1ResolutionFolder_h 1
+
+#include "globals.hh"
+
+/// Gaussian energy resolution of the Ge detector:
+///
+///   sigma^2(E) = (noise FWHM / 2.355)^2 + F * w * E
+///
+/// with the Fano factor F (0.11 by default), the pair creation energy w
+/// (2.96 eV) and the FWHM of the electronic noise (150 eV).
+///
+/// Fold() broadens an energy with the Box-Muller transform of two uniform
+/// random numbers, drawn from the engine of the thread within the event:
+/// no Gaussian is cached from one event to the next, so the folded
+/// spectrum does not depend on the thread layout.
+
+class B1ResolutionFolder
+{
+  public:
+    B1ResolutionFolder();
+   ~B1ResolutionFolder();
+
+    G4double Fold(G4double energy) const;
+    G4double GetSigma(G4double energy) const;
+
+    void SetFanoFactor(G4double fano)      { fFano = fano; }
+    void SetPairEnergy(G4double pairEnergy) { fPairEnergy = pairEnergy; }
+    void SetNoiseFwhm(G4double fwhm)        { fNoiseFwhm = fwhm; }
+
+  private:
+    G4double fFano;
+    G4double fPairEnergy;
+    G4double fNoiseFwhm;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
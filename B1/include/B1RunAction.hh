@@ -34,31 +34,79 @@
 #include "G4Accumulable.hh"
 #include "globals.hh"
 
+#include "B1StopCondition.hh"
+#include "B1ScanScheduler.hh"
+#include "B1StackFilter.hh"
+
 class G4Run;
 class HistoManager;
+class B1Profiler;
+class B1TrackingAction;
+class B1SteppingAction;
+class B1PrimaryGeneratorAction;
 
 /// Run action class
 ///
 /// In EndOfRunAction(), it calculates the dose in the selected volume 
 /// from the energy deposit accumulated via stepping and event actions.
 /// The computed dose is then printed on the screen.
+/// It also counts the events passing the trigger threshold of
+/// B1EventAction, for the normalisation of the spectra.
+/// It owns the profiler of its thread and registers it with the
+/// accumulables; the master prints its report.
+/// It also feeds the precision target (B1StopCondition) with the events
+/// of its thread and soft-aborts the run once the target is reached.
+/// Likewise, it feeds the adaptive scan (B1ScanScheduler) with the scores
+/// of the batches of its thread.
+/// It owns the tracking and stepping actions of its thread and installs
+/// them for a run only if they have work to do (profiling of the steps,
+/// importance sampling), so that no user call is made per step otherwise.
+/// In the batch executable (B1_BATCH) it turns the trajectory storage
+/// off once per run.
+/// It counts the tracks dropped by the stacking filter (B1StackFilter),
+/// by reason; the master prints the killed and the deferred tracks
+/// separately.
 
 class B1RunAction : public G4UserRunAction
 {
   public:
-    B1RunAction(HistoManager*);
+    B1RunAction(HistoManager*, B1Profiler*, B1StopCondition*,
+                B1ScanScheduler*);
     virtual ~B1RunAction();
 
     // virtual G4Run* GenerateRun();
     virtual void BeginOfRunAction(const G4Run*);
     virtual void   EndOfRunAction(const G4Run*);
 
-    void AddEdep (G4double edep); 
+    // each weighted Edep of an event, then EndEvent() once per event
+    void AddEdep (G4double edep, G4double weight = 1.);
+    void EndEvent();
+    void AddScanEdep(G4int point, G4double edep, G4double weight = 1.);
+    void CountTriggered() { fNofTriggered += 1; }
+    void CountStacked(G4int counter) { fNofStacked[counter] += 1; }
+    void CheckStop();
+
+    // takes ownership
+    void SetTrackingActions(B1TrackingAction*, B1SteppingAction*);
+    // the generator of this thread, whose event numbers advance per run
+    void SetPrimaryGenerator(B1PrimaryGeneratorAction* generator)
+      { fGenerator = generator; }
 
   private:
     HistoManager* fHistoManager;
+    B1Profiler*   fProfiler;
+    B1TrackingAction* fTrackingAction;
+    B1SteppingAction* fSteppingAction;
+    B1PrimaryGeneratorAction* fGenerator;
     G4Accumulable<G4double> fEdep;
     G4Accumulable<G4double> fEdep2;
+    G4double                fEventEdep;
+    G4Accumulable<G4int>    fNofTriggered;
+    G4Accumulable<G4int>    fNofStacked[B1StackFilter::kNofCounters];
+    B1StopCondition*        fStop;
+    B1StopCondition::Sums   fStopSums;
+    B1ScanScheduler*        fScan;
+    B1ScanScheduler::Sums   fScanSums;
 };
 
 #endif
@@ -0,0 +1,93 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1RunSummary.hh
+/// \brief Definition of the B1RunSummary class
+
+#ifndef B1RunSummary_h
+#define B1RunSummary_h 1
+
+#include "globals.hh"
+
+#include "g4root.hh"
+
+#include <vector>
+
+/// Result of one run in a form that can be merged without loss: the event
+/// counts, the fEdep/fEdep2 accumulables of B1RunAction and the full bin
+/// statistics of the H1 spectra.
+///
+/// The text file written by Write() holds the doubles in hexadecimal
+/// floating point, so that Read() restores them exactly. Add() sums two
+/// summaries, so merging the shards of a run in a fixed order gives the
+/// same bits whatever the number of processes that wrote them.
+
+class B1RunSummary
+{
+  public:
+    B1RunSummary();
+   ~B1RunSummary();
+
+    void SetRun(G4int nofEvents, G4int nofTriggered,
+                G4double edep, G4double edep2);
+    void AddHisto(const G4String& name, const G4String& title,
+                  const tools::histo::h1d& h1);
+
+    G4bool Write(const G4String& fileName) const;
+    G4bool Read(const G4String& fileName);
+
+    // false if the histograms of the two summaries differ in binning
+    G4bool Add(const B1RunSummary& other);
+
+    // books the histograms in the current analysis file
+    void BookHistos(G4AnalysisManager* analysisManager) const;
+
+    G4int    GetNofEvents() const    { return fNofEvents; }
+    G4int    GetNofTriggered() const { return fNofTriggered; }
+    G4double GetEdep() const         { return fEdep; }
+    G4double GetEdep2() const        { return fEdep2; }
+
+  private:
+    // statistics of one tools::histo::h1d, under- and overflow included
+    struct Histo {
+      G4String fName;
+      G4String fTitle;
+      G4int    fNbins;
+      G4double fXmin, fXmax;
+      G4bool   fLog;     // logarithmic binning
+      std::vector<unsigned int> fEntries;
+      std::vector<G4double> fSw, fSw2, fSxw, fSx2w;
+    };
+
+    G4int    fNofEvents;
+    G4int    fNofTriggered;
+    G4double fEdep;
+    G4double fEdep2;
+    std::vector<Histo> fHistos;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,91 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1ScanGrid.hh
+/// \brief Definition of the B1ScanGrid class
+
+#ifndef B1ScanGrid_h
+#define B1ScanGrid_h 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+
+class B1ScanMessenger;
+class B1ScanScheduler;
+
+/// Grid of source positions scanned in a single run (/B1/scan/ directory).
+///
+/// The grid is the product of three axes, each with n equally spaced
+/// values from min to max (one value, min, with n = 1). Point i is at
+/// (x[i % nx], y[(i / nx) % ny], z[i / (nx*ny)]). Without /B1/scan/adaptive
+/// the event number, as used by the per-event seeding, selects the point,
+/// so that all points get the same number of events, to one.
+///
+/// With /B1/scan/cone, the emission of the line source is restricted to a
+/// cone around +z, towards the crystal, and weighted by its solid angle
+/// fraction; the ion source decays isotropically in all cases.
+///
+/// With /B1/scan/adaptive, the points are instead handed out in batches by
+/// the B1ScanScheduler owned by the grid, in an order which depends on the
+/// thread timing: the point of an event is then not reproducible.
+///
+/// One instance is shared by all threads; it is only changed between runs.
+
+class B1ScanGrid
+{
+  public:
+    B1ScanGrid();
+   ~B1ScanGrid();
+
+    void SetEnabled(G4bool flag) { fEnabled = flag; }
+    void SetAxis(G4int axis, G4double min, G4double max, G4int n);
+    void SetConeAngle(G4double angle) { fConeAngle = angle; }
+
+    G4bool IsActive() const { return fEnabled; }
+    G4int  GetNofPoints() const { return fN[0]*fN[1]*fN[2]; }
+    G4ThreeVector GetPosition(G4int point) const;
+    G4double GetConeAngle() const { return fConeAngle; }
+
+    G4int SelectPoint(G4long eventNumber) const
+      { return G4int(eventNumber % GetNofPoints()); }
+
+    B1ScanScheduler* GetScheduler() const { return fScheduler; }
+
+  private:
+    G4double GetValue(G4int axis, G4int i) const;
+
+    B1ScanMessenger* fMessenger;
+    B1ScanScheduler* fScheduler;
+
+    G4bool   fEnabled;
+    G4double fMin[3];
+    G4double fMax[3];
+    G4int    fN[3];
+    G4double fConeAngle;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
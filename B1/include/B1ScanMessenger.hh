@@ -0,0 +1,71 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1ScanMessenger.hh
+/// \brief Definition of the B1ScanMessenger class
+
+#ifndef B1ScanMessenger_h
+#define B1ScanMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class B1ScanGrid;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithABool;
+class G4UIcmdWithADouble;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADoubleAndUnit;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Messenger for the source position scan (/B1/scan/ directory).
+/// The grid is shared by all threads, the commands are not broadcast.
+
+class B1ScanMessenger: public G4UImessenger
+{
+  public:
+    B1ScanMessenger(B1ScanGrid*);
+   ~B1ScanMessenger();
+
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    G4UIcommand* CreateAxisCommand(const G4String& axis);
+
+    B1ScanGrid*                fGrid;
+
+    G4UIdirectory*             fScanDir;
+    G4UIcmdWithABool*          fEnableCmd;
+    G4UIcommand*               fAxisCmd[3];
+    G4UIcmdWithADoubleAndUnit* fConeCmd;
+    G4UIcmdWithADouble*        fAdaptiveCmd;
+    G4UIcmdWithAnInteger*      fBatchSizeCmd;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,110 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1ScanScheduler.hh
+/// \brief Definition of the B1ScanScheduler class
+
+#ifndef B1ScanScheduler_h
+#define B1ScanScheduler_h 1
+
+#include "globals.hh"
+#include "G4Threading.hh"
+
+#include <atomic>
+#include <vector>
+
+class B1ScanGrid;
+
+/// Adaptive allocation of the events of a scan (/B1/scan/adaptive).
+///
+/// The score of an event is its weighted energy deposit, as accumulated
+/// by B1RunAction; the scheduler tracks its mean and variance per point.
+/// The threads take the events in batches of /B1/scan/batchSize events of
+/// one point. Each point first gets one batch; then each new batch goes
+/// to the point with the largest relative uncertainty on its mean score,
+/// extrapolated to the events already handed out. The run stops once all
+/// points reach the target; points without any energy deposit after one
+/// batch are reported and left out.
+///
+/// The batches go to the threads in the order they ask for them, and the
+/// point of a batch depends on the scores published so far: the point of
+/// an event depends on the thread timing, not on its event number. An
+/// adaptive scan is therefore not reproducible, even with per-event
+/// seeding (/B1/random/eventSeeds) and a fixed number of threads, and the
+/// shards of a sharded job (-j) each run their own allocation.
+///
+/// One instance, owned by the scan grid, is shared by all threads: the
+/// lock is only taken once per batch.
+
+class B1ScanScheduler
+{
+  public:
+    // scores of the events of one thread at one point
+    struct Sums {
+      Sums() : fPoint(-1), fNofEvents(0), fSx(0.), fSx2(0.) {}
+      G4int    fPoint;
+      G4int    fNofEvents;
+      G4double fSx, fSx2;
+    };
+
+    B1ScanScheduler(const B1ScanGrid* grid);
+   ~B1ScanScheduler();
+
+    // relative uncertainty target, 0: the points get equal numbers of events
+    void SetPrecision(G4double relError) { fPrecision = relError; }
+    void SetBatchSize(G4int nofEvents) { fBatchSize = nofEvents; }
+
+    G4bool IsActive() const;
+    G4int  GetBatchSize() const { return fBatchSize; }
+    G4bool IsDone() const { return fDone.load(std::memory_order_relaxed); }
+    G4int  GetRunIndex() const { return fRunIndex.load(); }
+
+    // master, begin and end of run
+    void Reset();
+    void Report() const;
+
+    // threads: the point of the next batch, and the scores of the events
+    G4int NextBatch();
+    void  Publish(Sums& sums);
+
+  private:
+    // relative uncertainty of the mean score of a point, < 0 without score
+    G4double RelativeError(G4int point) const;
+
+    const B1ScanGrid* fGrid;
+    G4double fPrecision;
+    G4int    fBatchSize;
+
+    G4Mutex               fMutex;
+    std::vector<G4int>    fNofEvents;
+    std::vector<G4int>    fPending;    // events handed out, not published
+    std::vector<G4double> fSx, fSx2;
+    std::atomic<bool>     fDone;
+    std::atomic<int>      fRunIndex;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,84 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1ShardLauncher.hh
+/// \brief Definition of the B1ShardLauncher class
+
+#ifndef B1ShardLauncher_h
+#define B1ShardLauncher_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+/// Runs one job as several processes on one node (exampleB1 -j).
+///
+/// Launch() forks one process per shard before any Geant4 object exists.
+/// Each shard runs its own (multi-threaded) run manager on:
+/// - a contiguous block of the events, the first nofEvents % nofShards
+///   shards taking one event more;
+/// - per-event seeds from (seed, event number), see
+///   B1PrimaryGeneratorAction, so that the events do not depend on the
+///   number of shards;
+/// - its own slice of the CPUs of the process affinity mask (Linux);
+/// - its own output, <output>_shard<i>.root/.log/.sum.
+/// Once all shards exited, Merge() adds their B1RunSummary files in shard
+/// order into <output>.sum and writes the merged spectra to <output>.root.
+
+class B1ShardLauncher
+{
+  public:
+    B1ShardLauncher(G4int nofShards, G4int nofEvents, G4long seed,
+                    const G4String& output);
+   ~B1ShardLauncher();
+
+    // Returns the shard index in each child process, and -1 in the parent
+    // once all the children have exited.
+    G4int Launch();
+
+    // Parent: merges the shard summaries; false if a shard failed
+    G4bool Merge() const;
+
+    G4int    GetNofShards() const { return fNofShards; }
+    G4int    GetNofEvents(G4int shard) const;
+    G4int    GetFirstEvent(G4int shard) const;
+    G4long   GetSeed() const { return fSeed; }
+    G4String GetShardName(G4int shard) const;
+    G4int    GetNofCpus() const { return fNofCpus; }
+
+  private:
+    void StartShard(G4int shard);
+
+    G4int    fNofShards;
+    G4int    fNofEvents;
+    G4long   fSeed;
+    G4String fOutput;
+    G4int    fNofCpus;          // CPUs of the current shard
+    std::vector<G4int> fStatus; // exit status of the shards
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
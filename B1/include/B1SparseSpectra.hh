@@ -0,0 +1,110 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1SparseSpectra.hh
+/// \brief Definition of the B1SparseSpectra class
+
+#ifndef B1SparseSpectra_h
+#define B1SparseSpectra_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <unordered_map>
+#include <vector>
+
+/// Fine-binned spectra of which only the filled bins are stored
+/// (/B1/histo/addSparse), so that e.g. 1 eV bins over 10 MeV take memory
+/// in proportion to the number of distinct energies deposited rather than
+/// to the number of bins.
+///
+/// Each spectrum is a hash map from the bin index to the entries, the sum
+/// of weights and the sum of squared weights; index -1 holds the underflow
+/// and nbins the overflow. One instance per thread, owned by HistoManager
+/// and registered by B1RunAction with its accumulables, so the maps are
+/// added on the master, which writes one text file per spectrum.
+
+class B1SparseSpectra : public G4VAccumulable
+{
+  public:
+    B1SparseSpectra();
+    virtual ~B1SparseSpectra();
+
+    // methods from the base class
+    virtual void Merge(const G4VAccumulable& other);
+    virtual void Reset();
+
+    void AddSpectrum(const G4String& name, G4double binWidth,
+                     G4double emin, G4double emax);
+    void Clear();
+
+    std::size_t GetNofSpectra() const { return fSpectra.size(); }
+
+    inline void Fill(G4double energy, G4double weight);
+
+    // master: writes <baseName>_<spectrum name>.txt per spectrum
+    void Write(const G4String& baseName) const;
+
+  private:
+    struct Bin {
+      Bin() : fEntries(0), fSw(0.), fSw2(0.) {}
+      unsigned int fEntries;
+      G4double     fSw, fSw2;
+    };
+    typedef std::unordered_map<G4long, Bin> BinMap;
+
+    struct Spectrum {
+      G4String fName;
+      G4double fBinWidth;
+      G4double fEmin, fEmax;
+      G4long   fNbins;
+      BinMap   fBins;
+    };
+
+    std::vector<Spectrum> fSpectra;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void B1SparseSpectra::Fill(G4double energy, G4double weight)
+{
+  for (std::size_t is = 0; is < fSpectra.size(); ++is) {
+    Spectrum& spectrum = fSpectra[is];
+    G4long i;
+    if (energy < spectrum.fEmin)       i = -1;
+    else if (energy >= spectrum.fEmax) i = spectrum.fNbins;
+    else i = G4long((energy - spectrum.fEmin)/spectrum.fBinWidth);
+    if (i > spectrum.fNbins) i = spectrum.fNbins;
+
+    Bin& bin = spectrum.fBins[i];
+    bin.fEntries++;
+    bin.fSw  += weight;
+    bin.fSw2 += weight*weight;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,112 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1StackFilter.hh
+/// \brief Definition of the B1StackFilter class
+
+#ifndef B1StackFilter_h
+#define B1StackFilter_h 1
+
+#include "G4ClassificationOfNewTrack.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class B1StackMessenger;
+class G4ParticleDefinition;
+class G4Track;
+
+/// Selection of the secondaries B1StackingAction never tracks
+/// (/B1/stack/ directory).
+///
+/// A new secondary is killed if it is a neutrino, a stable ion in its
+/// ground state (the Fe-57 recoil of the Co-57 decay), or if it is
+/// created outside the global time window (the daughters of the Co-57
+/// decay carry global times of the order of its lifetime, not of ns).
+/// Otherwise the user rules are tried in order: a rule matches a
+/// particle type (or any), a maximum kinetic energy (or any) and the
+/// volume the secondary is created in (or any), and kills or defers the
+/// first secondary it matches.
+/// Deferred tracks are put in the waiting stack and only tracked once
+/// the urgent stack is empty.
+///
+/// The primaries and the copies of an importance split are never
+/// filtered, so that the copies stay identical to the split track.
+/// Neutrinos and stable ions are killed by default; there is no time
+/// window and no rule by default.
+///
+/// One instance is shared by all threads; it is only changed between runs.
+
+class B1StackFilter
+{
+  public:
+    // the counters of the filtered tracks
+    enum Counter {
+      kNeutrino = 0, kStableIon, kTimeWindow, kRuleKill, kRuleDefer,
+      kNofCounters
+    };
+
+    B1StackFilter();
+   ~B1StackFilter();
+
+    void SetEnabled(G4bool flag)        { fEnabled = flag; }
+    void SetKillNeutrinos(G4bool flag)  { fKillNeutrinos = flag; }
+    void SetKillStableIons(G4bool flag) { fKillStableIons = flag; }
+    void SetTimeWindow(G4double tmin, G4double tmax);
+    // particle "all": any particle, emax 0: any energy, volume "all": any
+    void AddRule(const G4String& particle, G4double emax,
+                 const G4String& volume, G4bool defer);
+    void ClearRules() { fRules.clear(); }
+
+    G4bool IsActive() const { return fEnabled; }
+
+    // counter: the counter to increment, -1 if the track is not filtered
+    G4ClassificationOfNewTrack Classify(const G4Track* track,
+                                        G4int& counter) const;
+
+    static const char* GetCounterName(G4int counter);
+    void Print() const;
+
+  private:
+    struct Rule {
+      const G4ParticleDefinition* fParticle;
+      G4double                    fEmax;
+      G4String                    fVolume;
+      G4bool                      fDefer;
+    };
+
+    B1StackMessenger* fMessenger;
+
+    G4bool   fEnabled;
+    G4bool   fKillNeutrinos;
+    G4bool   fKillStableIons;
+    G4double fTimeMin;
+    G4double fTimeMax;
+    std::vector<Rule> fRules;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
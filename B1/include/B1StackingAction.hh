@@ -0,0 +1,61 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1StackingAction.hh
+/// \brief Definition of the B1StackingAction class
+
+#ifndef B1StackingAction_h
+#define B1StackingAction_h 1
+
+#include "G4UserStackingAction.hh"
+#include "globals.hh"
+
+class B1StackFilter;
+class B1RunAction;
+
+/// Stacking action class
+///
+/// Classifies the new tracks with the shared stacking filter
+/// (B1StackFilter), so that the secondaries irrelevant to the Ge spectrum
+/// are never tracked, and counts the filtered tracks in the run action
+/// of its thread.
+
+class B1StackingAction : public G4UserStackingAction
+{
+  public:
+    B1StackingAction(const B1StackFilter* filter, B1RunAction* runAction);
+    virtual ~B1StackingAction();
+
+    // method from the base class
+    virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track*);
+
+  private:
+    const B1StackFilter* fFilter;
+    B1RunAction*         fRunAction;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
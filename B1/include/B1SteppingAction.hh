@@ -23,7 +23,6 @@
 // * acceptance of all terms of the Geant4 Software license.          *
 // ********************************************************************
 //
-//
 /// \file B1SteppingAction.hh
 /// \brief Definition of the B1SteppingAction class
 
@@ -33,25 +32,58 @@
 #include "G4UserSteppingAction.hh"
 #include "globals.hh"
 
-class B1EventAction;
+#include <map>
 
-class G4LogicalVolume;
+class B1Profiler;
+class B1ImportanceMap;
+class B1HistoryTree;
+class G4Track;
+class G4VPhysicalVolume;
 
 /// Stepping action class
-/// 
+///
+/// The energy deposit is scored by B1GeSD; the stepping action feeds the
+/// profiler, when it is enabled, and applies the importance splitting and
+/// Russian roulette (B1ImportanceMap) at the volume boundaries, recording
+/// them in the history tree of the event (B1HistoryTree). It is only
+/// installed for the runs which need either (B1RunAction).
+///
+/// The importances, set by volume name, are resolved to the physical
+/// volumes at the start of each run (BeginOfRun()), so that a boundary
+/// crossing only costs a lookup by pointer.
 
 class B1SteppingAction : public G4UserSteppingAction
 {
   public:
-    B1SteppingAction(B1EventAction* eventAction);
+    B1SteppingAction(B1Profiler* profiler, const B1ImportanceMap* importance,
+                     B1HistoryTree* history);
     virtual ~B1SteppingAction();
 
     // method from the base class
     virtual void UserSteppingAction(const G4Step*);
 
+    // whether the next run needs this action
+    G4bool IsNeeded() const;
+    // start of a run in which this action is installed
+    void BeginOfRun();
+
   private:
-    B1EventAction*  fEventAction;
-    G4LogicalVolume* fScoringVolume;
+    void SampleImportance(const G4Step*);
+    void SplitTrack(G4Track* track, G4int branch, G4int nofCopies,
+                    G4double importance);
+    G4bool IsMovingTowardsCrystal(const G4Track* track);
+    G4double GetImportance(const G4VPhysicalVolume* volume) const;
+
+    B1Profiler*            fProfiler;
+    const B1ImportanceMap* fImportance;
+    B1HistoryTree*         fHistory;
+
+    // secondaries of the current track already given their branch
+    std::size_t        fNofSecondaries;
+    G4VPhysicalVolume* fCrystal;
+
+    // importance of each physical volume, for this run
+    std::map<const G4VPhysicalVolume*, G4double> fVolumeImportance;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,137 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1StopCondition.hh
+/// \brief Definition of the B1StopCondition class
+
+#ifndef B1StopCondition_h
+#define B1StopCondition_h 1
+
+#include "globals.hh"
+#include "G4Threading.hh"
+
+#include <atomic>
+
+class B1StopMessenger;
+
+/// Precision target of a run (/B1/stop/ directory).
+///
+/// The run is stopped as soon as the relative uncertainty of the peak area
+/// in a region of interest of the Edep spectrum (e.g. the 14.4 keV line)
+/// reaches the target. The area is the sum of the event weights in the
+/// ROI, optionally minus the background estimated from two side bands of
+/// half the ROI width each, next to it. Under importance sampling an
+/// event is filled as several weighted alternatives: their weights are
+/// summed per event, and the variance takes the square of that sum.
+///
+/// One instance is shared by all threads. Each thread accumulates its
+/// events in its own Sums and publishes them every /B1/stop/checkEvery
+/// events: the only lock is taken there. The first thread that finds the
+/// target reached raises a flag; every worker then soft-aborts its event
+/// loop at its next event, so the run ends after the events in flight.
+
+class B1StopCondition
+{
+  public:
+    // partial sums of the events of one thread
+    struct Sums {
+      Sums() : fNofEvents(0), fRoiW(0.), fRoiW2(0.), fSideW(0.), fSideW2(0.),
+               fEventRoiW(0.), fEventSideW(0.) {}
+      G4int    fNofEvents;
+      G4double fRoiW, fRoiW2;     // in the ROI
+      G4double fSideW, fSideW2;   // in the side bands
+      G4double fEventRoiW, fEventSideW;   // of the current event
+    };
+
+    B1StopCondition();
+   ~B1StopCondition();
+
+    void SetPrecision(G4double relError) { fPrecision = relError; }
+    void SetRoi(G4double emin, G4double emax);
+    void SetBackgroundSubtraction(G4bool flag) { fSubtractBackground = flag; }
+    void SetCheckInterval(G4int nofEvents) { fCheckInterval = nofEvents; }
+    void SetMinEvents(G4int nofEvents) { fMinEvents = nofEvents; }
+
+    G4bool IsActive() const { return fPrecision > 0. && fRoiMax > fRoiMin; }
+
+    // thread local, each weighted Edep of an event, then once per event
+    inline void Fill(Sums& sums, G4double edep, G4double weight) const;
+    inline void EndEvent(Sums& sums) const;
+    G4bool IsCheckDue(const Sums& sums) const
+      { return sums.fNofEvents >= fCheckInterval; }
+    G4bool IsReached() const { return fReached.load(std::memory_order_relaxed); }
+
+    // adds the thread sums to the run totals and resets them;
+    // returns true once the target is reached
+    G4bool Publish(Sums& sums);
+
+    // master, begin and end of run
+    void Reset();
+    void Report() const;
+
+  private:
+    // relative uncertainty of the area of the totals, < 0 if undefined
+    G4double RelativeError(G4double& area, G4double& error) const;
+
+    B1StopMessenger* fMessenger;
+
+    G4double fPrecision;
+    G4double fRoiMin, fRoiMax;
+    G4double fSideMin, fSideMax;
+    G4bool   fSubtractBackground;
+    G4int    fCheckInterval;
+    G4int    fMinEvents;
+
+    G4Mutex           fMutex;
+    Sums              fTotal;
+    std::atomic<bool> fReached;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void B1StopCondition::Fill(Sums& sums, G4double edep,
+                                  G4double weight) const
+{
+  if (edep < fSideMin || edep >= fSideMax) return;
+  if (edep >= fRoiMin && edep < fRoiMax) sums.fEventRoiW  += weight;
+  else                                   sums.fEventSideW += weight;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void B1StopCondition::EndEvent(Sums& sums) const
+{
+  sums.fNofEvents++;
+  sums.fRoiW   += sums.fEventRoiW;
+  sums.fRoiW2  += sums.fEventRoiW*sums.fEventRoiW;
+  sums.fSideW  += sums.fEventSideW;
+  sums.fSideW2 += sums.fEventSideW*sums.fEventSideW;
+  sums.fEventRoiW  = 0.;
+  sums.fEventSideW = 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,69 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1StopMessenger.hh
+/// \brief Definition of the B1StopMessenger class
+
+#ifndef B1StopMessenger_h
+#define B1StopMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class B1StopCondition;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithADouble;
+class G4UIcmdWithABool;
+class G4UIcmdWithAnInteger;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Messenger for the precision target of the run (/B1/stop/ directory).
+/// The stop condition is shared by all threads, the commands are not
+/// broadcast.
+
+class B1StopMessenger: public G4UImessenger
+{
+  public:
+    B1StopMessenger(B1StopCondition*);
+   ~B1StopMessenger();
+
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    B1StopCondition*      fStop;
+
+    G4UIdirectory*        fStopDir;
+    G4UIcmdWithADouble*   fPrecisionCmd;
+    G4UIcommand*          fRoiCmd;
+    G4UIcmdWithABool*     fBackgroundCmd;
+    G4UIcmdWithAnInteger* fCheckEveryCmd;
+    G4UIcmdWithAnInteger* fMinEventsCmd;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,76 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1TrackInformation.hh
+/// \brief Definition of the B1TrackInformation class
+
+#ifndef B1TrackInformation_h
+#define B1TrackInformation_h 1
+
+#include "G4VUserTrackInformation.hh"
+#include "G4Track.hh"
+#include "globals.hh"
+
+/// Track information class
+///
+/// Under importance sampling (B1ImportanceMap), carries the branch of the
+/// event history the track belongs to (B1HistoryTree) and the importance
+/// its population currently corresponds to. The secondaries inherit both
+/// from their parent, but not the flag of the copies made by a split.
+/// Tracks without information are in branch 0, the unsplit history, at
+/// importance 1.
+
+class B1TrackInformation : public G4VUserTrackInformation
+{
+  public:
+    B1TrackInformation(G4int branch, G4double importance,
+                       G4bool splitCopy = false);
+    virtual ~B1TrackInformation();
+
+    // method from the base class
+    virtual void Print() const;
+
+    G4int    GetBranch() const     { return fBranch; }
+    G4double GetImportance() const { return fImportance; }
+    G4bool   IsSplitCopy() const   { return fSplitCopy; }
+    void SetBranch(G4int branch)          { fBranch = branch; }
+    void SetImportance(G4double importance) { fImportance = importance; }
+
+    static G4int GetBranch(const G4Track* track)
+    {
+      const B1TrackInformation* info
+        = static_cast<const B1TrackInformation*>(track->GetUserInformation());
+      return info ? info->fBranch : 0;
+    }
+
+  private:
+    G4int    fBranch;
+    G4double fImportance;
+    G4bool   fSplitCopy;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
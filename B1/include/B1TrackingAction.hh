@@ -0,0 +1,61 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1TrackingAction.hh
+/// \brief Definition of the B1TrackingAction class
+
+#ifndef B1TrackingAction_h
+#define B1TrackingAction_h 1
+
+#include "G4UserTrackingAction.hh"
+#include "globals.hh"
+
+class B1Profiler;
+
+/// Tracking action class
+///
+/// Starts the step clock of the profiler for each track, so that the
+/// first step is not charged with the time spent between tracks.
+/// It is only installed for the runs which need it (B1RunAction).
+
+class B1TrackingAction : public G4UserTrackingAction
+{
+  public:
+    B1TrackingAction(B1Profiler* profiler);
+    virtual ~B1TrackingAction();
+
+    // method from the base class
+    virtual void PreUserTrackingAction(const G4Track*);
+
+    // whether the next run needs this action
+    G4bool IsNeeded() const;
+
+  private:
+    B1Profiler* fProfiler;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
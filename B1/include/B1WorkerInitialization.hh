@@ -0,0 +1,72 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1WorkerInitialization.hh
+/// \brief Definition of the B1WorkerInitialization class
+
+#ifndef B1WorkerInitialization_h
+#define B1WorkerInitialization_h 1
+
+#include "G4UserWorkerInitialization.hh"
+#include "globals.hh"
+
+#include <vector>
+
+/// Worker initialization class
+///
+/// Pins each worker thread when it starts, either to one CPU (core mode)
+/// or to the CPUs of one NUMA node (numa mode). Only the CPUs of the
+/// affinity mask the process was started with are used, so that a job
+/// confined to a cpuset by a batch scheduler stays inside it. Workers are
+/// assigned round-robin by thread id. Linux only; elsewhere the threads
+/// are left unpinned.
+
+class B1WorkerInitialization : public G4UserWorkerInitialization
+{
+  public:
+    enum AffinityMode { kAffinityNone, kAffinityCore, kAffinityNuma };
+
+    B1WorkerInitialization(AffinityMode mode);
+    virtual ~B1WorkerInitialization();
+
+    // method from the base class
+    virtual void WorkerStart() const;
+
+    // number of usable CPUs and NUMA nodes
+    G4int GetNumberOfCpus() const { return fCpus.size(); }
+    G4int GetNumberOfNodes() const { return fNodes.size(); }
+
+  private:
+    void ReadCpuSet();
+    void ReadNodes();
+
+    AffinityMode fMode;
+    std::vector<G4int> fCpus;                // CPUs of the process mask
+    std::vector<std::vector<G4int> > fNodes; // the same, grouped by node
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
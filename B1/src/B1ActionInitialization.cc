@@ -33,25 +33,50 @@
 #include "B1RunAction.hh"
 #include "B1EventAction.hh"
 #include "B1SteppingAction.hh"
+#include "B1TrackingAction.hh"
+#include "B1StackingAction.hh"
 #include "B1HistoManager.hh"
+#include "B1Profiler.hh"
+#include "B1StopCondition.hh"
+#include "B1ScanGrid.hh"
+#include "B1ImportanceMap.hh"
+#include "B1HistoryTree.hh"
+#include "B1StackFilter.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1ActionInitialization::B1ActionInitialization()
- : G4VUserActionInitialization()
-{}
+ : G4VUserActionInitialization(),
+   fStopCondition(0),
+   fScanGrid(0),
+   fImportanceMap(0),
+   fStackFilter(0)
+{
+  fStopCondition = new B1StopCondition();
+  fScanGrid = new B1ScanGrid();
+  fImportanceMap = new B1ImportanceMap();
+  fStackFilter = new B1StackFilter();
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1ActionInitialization::~B1ActionInitialization()
-{}
+{
+  delete fStackFilter;
+  delete fImportanceMap;
+  delete fScanGrid;
+  delete fStopCondition;
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 void B1ActionInitialization::BuildForMaster() const
 {
   HistoManager*  histo = new HistoManager();
-  B1RunAction* runAction = new B1RunAction(histo);
+  histo->SetScanGrid(fScanGrid);
+  B1Profiler* profiler = new B1Profiler();
+  B1RunAction* runAction = new B1RunAction(histo, profiler, fStopCondition,
+                                           fScanGrid->GetScheduler());
   SetUserAction(runAction);
 }
 
@@ -59,15 +84,27 @@ void B1ActionInitialization::BuildForMaster() const
 
 void B1ActionInitialization::Build() const
 {
-  SetUserAction(new B1PrimaryGeneratorAction);
+  B1Profiler* profiler = new B1Profiler();
+  B1PrimaryGeneratorAction* generator
+    = new B1PrimaryGeneratorAction(profiler, fScanGrid);
+  SetUserAction(generator);
   HistoManager*  histo = new HistoManager();
-  B1RunAction* runAction = new B1RunAction(histo);
+  histo->SetScanGrid(fScanGrid);
+  B1RunAction* runAction = new B1RunAction(histo, profiler, fStopCondition,
+                                           fScanGrid->GetScheduler());
+  runAction->SetPrimaryGenerator(generator);
   SetUserAction(runAction);
   
-  B1EventAction* eventAction = new B1EventAction(runAction,histo);
+  B1HistoryTree* history = new B1HistoryTree(fImportanceMap);
+  B1EventAction* eventAction
+    = new B1EventAction(runAction,histo,profiler,history);
   SetUserAction(eventAction);
-  
-  SetUserAction(new B1SteppingAction(eventAction));
+
+  SetUserAction(new B1StackingAction(fStackFilter, runAction));
+  // installed by the run action, for the runs which need them
+  runAction->SetTrackingActions(
+    new B1TrackingAction(profiler),
+    new B1SteppingAction(profiler, fImportanceMap, history));
 }  
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,85 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1AliasTable.cc
+/// \brief Implementation of the B1AliasTable class
+
+#include "B1AliasTable.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AliasTable::B1AliasTable()
+ : fTotalWeight(0.)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AliasTable::B1AliasTable(const std::vector<G4double>& weights)
+ : fTotalWeight(0.)
+{
+  Build(weights);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AliasTable::~B1AliasTable()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AliasTable::Build(const std::vector<G4double>& weights)
+{
+  // Vose's variant of the Walker method
+  std::size_t n = weights.size();
+  fProb.assign(n, 1.);
+  fAlias.resize(n);
+  fTotalWeight = 0.;
+  for (std::size_t i = 0; i < n; ++i) fTotalWeight += weights[i];
+  if (n == 0 || fTotalWeight <= 0.) return;
+
+  std::vector<G4double> scaled(n);
+  std::vector<std::size_t> small, large;
+  for (std::size_t i = 0; i < n; ++i) {
+    fAlias[i] = i;
+    scaled[i] = weights[i]*n/fTotalWeight;
+    if (scaled[i] < 1.) small.push_back(i);
+    else                large.push_back(i);
+  }
+
+  while (! small.empty() && ! large.empty()) {
+    std::size_t s = small.back(); small.pop_back();
+    std::size_t l = large.back(); large.pop_back();
+    fProb[s] = scaled[s];
+    fAlias[s] = l;
+    scaled[l] = (scaled[l] + scaled[s]) - 1.;
+    if (scaled[l] < 1.) small.push_back(l);
+    else                large.push_back(l);
+  }
+  // left-overs are 1 up to rounding
+  while (! large.empty()) { fProb[large.back()] = 1.; large.pop_back(); }
+  while (! small.empty()) { fProb[small.back()] = 1.; small.pop_back(); }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
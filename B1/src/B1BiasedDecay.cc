@@ -0,0 +1,192 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1BiasedDecay.cc
+/// \brief Implementation of the B1BiasedDecay class
+
+#include "B1BiasedDecay.hh"
+#include "B1EventInformation.hh"
+
+#include "G4VParticleChange.hh"
+#include "G4Track.hh"
+#include "G4Gamma.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Cons.hh"
+#include "G4EventManager.hh"
+#include "G4Event.hh"
+#include "G4PhysicalConstants.hh"
+#include "Randomize.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1BiasedDecay::B1BiasedDecay(G4VProcess* decay, G4double coneProbability)
+ : G4WrapperProcess("B1BiasedDecay(" + decay->GetProcessName() + ")",
+                    decay->GetProcessType()),
+   fConeProbability(coneProbability)
+{
+  SetProcessSubType(decay->GetProcessSubType());
+  RegisterProcess(decay);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1BiasedDecay::~B1BiasedDecay()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4VParticleChange* B1BiasedDecay::AtRestDoIt(const G4Track& track,
+                                             const G4Step& step)
+{
+  G4VParticleChange* change = pRegProcess->AtRestDoIt(track, step);
+  BiasPhotons(change, track);
+  return change;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4VParticleChange* B1BiasedDecay::PostStepDoIt(const G4Track& track,
+                                               const G4Step& step)
+{
+  G4VParticleChange* change = pRegProcess->PostStepDoIt(track, step);
+  BiasPhotons(change, track);
+  return change;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1BiasedDecay::BiasPhotons(G4VParticleChange* change,
+                                const G4Track& track)
+{
+  G4int nofSecondaries = change->GetNumberOfSecondaries();
+  if (nofSecondaries == 0 || ! FindTargets()) return;
+
+  // vertex not in front of the targets: leave the decay alone
+  G4double cosMax = ConeCosine(track.GetPosition());
+  if (cosMax <= -1.) return;
+
+  // probability of the cone for an isotropic emission
+  G4double coneFraction = 0.5*(1. - cosMax);
+  G4double inWeight  = coneFraction/fConeProbability;
+  G4double outWeight = (fConeProbability < 1.)
+                     ? (1. - coneFraction)/(1. - fConeProbability) : 0.;
+
+  G4double weight = 1.;
+  G4bool biased = false;
+  for (G4int i = 0; i < nofSecondaries; ++i) {
+    G4Track* secondary = change->GetSecondary(i);
+    if (secondary->GetDefinition() != G4Gamma::Gamma()) continue;
+
+    G4double cosTheta;
+    if (G4UniformRand() < fConeProbability) {
+      cosTheta = cosMax + (1. - cosMax)*G4UniformRand();
+      weight *= inWeight;
+    }
+    else {
+      cosTheta = -1. + (cosMax + 1.)*G4UniformRand();
+      weight *= outWeight;
+    }
+    G4double sinTheta = std::sqrt((1. - cosTheta)*(1. + cosTheta));
+    G4double phi = twopi*G4UniformRand();
+    secondary->SetMomentumDirection(
+      G4ThreeVector(sinTheta*std::cos(phi), sinTheta*std::sin(phi), cosTheta));
+    biased = true;
+  }
+  if (! biased) return;
+
+  // the weight applies to the decay as a whole
+  for (G4int i = 0; i < nofSecondaries; ++i) {
+    G4Track* secondary = change->GetSecondary(i);
+    secondary->SetWeight(secondary->GetWeight()*weight);
+  }
+
+  // and to the event: the decays of a chain are biased one after the
+  // other, so the event weight is the product of all their weights
+  G4Event* event = G4EventManager::GetEventManager()->GetNonconstCurrentEvent();
+  if (! event) return;
+  B1EventInformation* info
+    = static_cast<B1EventInformation*>(event->GetUserInformation());
+  if (! info) {
+    info = new B1EventInformation();
+    event->SetUserInformation(info);
+  }
+  info->MultiplyDecayWeight(weight);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1BiasedDecay::FindTargets()
+{
+  if (! fTargetVolumes.empty()) return true;
+
+  // In order to avoid dependence on DetectorConstruction class
+  // the volumes are taken from G4PhysicalVolumeStore.
+  // The Envelope is placed at the origin, so the translations are global.
+  const char* names[] = { "Shape1_1", "Shape2" };
+  for (std::size_t i = 0; i < sizeof(names)/sizeof(names[0]); ++i) {
+    G4VPhysicalVolume* volume
+      = G4PhysicalVolumeStore::GetInstance()->GetVolume(names[i], false);
+    G4Cons* cons
+      = volume ? dynamic_cast<G4Cons*>(volume->GetLogicalVolume()->GetSolid())
+               : 0;
+    if (! cons) {
+      G4ExceptionDescription msg;
+      msg << "Volume " << names[i] << " of G4Cons shape not found.\n";
+      msg << "Perhaps you have changed geometry.\n";
+      msg << "The decay photons will not be biased.";
+      G4Exception("B1BiasedDecay::FindTargets()",
+       "B1Bias0001",JustWarning,msg);
+      fTargetVolumes.clear();
+      fTargetSolids.clear();
+      return false;
+    }
+    fTargetVolumes.push_back(volume);
+    fTargetSolids.push_back(cons);
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1BiasedDecay::ConeCosine(const G4ThreeVector& vertex) const
+{
+  // widest of the cones from the vertex to the rims of the front faces
+  G4double rho = vertex.perp();
+  G4double cosMax = 1.;
+  for (std::size_t i = 0; i < fTargetVolumes.size(); ++i) {
+    G4double frontZ = fTargetVolumes[i]->GetTranslation().z()
+                    - fTargetSolids[i]->GetZHalfLength();
+    G4double dz = frontZ - vertex.z();
+    if (dz <= 0.) return -1.;
+    G4double dr = fTargetSolids[i]->GetOuterRadiusMinusZ() + rho;
+    G4double cosTheta = dz/std::sqrt(dz*dz + dr*dr);
+    if (cosTheta < cosMax) cosMax = cosTheta;
+  }
+  return cosMax;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
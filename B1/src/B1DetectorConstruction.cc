@@ -28,6 +28,9 @@
 /// \brief Implementation of the B1DetectorConstruction class
 
 #include "B1DetectorConstruction.hh"
+#include "B1DetectorMessenger.hh"
+#include "B1GeSD.hh"
+#include "B1Hash.hh"
 
 #include "G4RunManager.hh"
 #include "G4NistManager.hh"
@@ -40,18 +43,52 @@
 #include "G4PVPlacement.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4SubtractionSolid.hh"
+#include "G4SDManager.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4ProductionCuts.hh"
+#include "G4UserLimits.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4Version.hh"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1DetectorConstruction::B1DetectorConstruction()
 : G4VUserDetectorConstruction(),
-  fScoringVolume(0)
-{ }
+  fScoringVolume(0),
+  fMessenger(0),
+  fDeadLayerThickness(1.*um),
+  fWindowThickness(0.6*mm),
+  fFrameZ(1.*cm),
+  fShieldZ(1.*cm),
+  fCrystalFrontZ(0.),
+  fDeadLayerSolid(0), fDeadLayerPV(0),
+  fWindowSolid(0), fWindowPV(0),
+  fFramePV(0), fShieldPV(0),
+  fOverlapCheckMode(kOverlapCached),
+  fOverlapCacheFile("B1overlaps.cache")
+{
+  // Default production cuts of the detector regions.
+  // The 1 um dead layer and the window need cuts of the order of their
+  // thickness, the crystal keeps the former global default.
+  fRegionCuts["Crystal"]   = 0.7*mm;
+  fRegionCuts["DeadLayer"] = 1.*um;
+  fRegionCuts["Window"]    = 10.*um;
+  fRegionCuts["Frame"]     = 0.1*mm;
+
+  fMessenger = new B1DetectorMessenger(this);
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1DetectorConstruction::~B1DetectorConstruction()
-{ }
+{
+  delete fMessenger;
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -65,9 +102,10 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
   G4double env_sizeXY = 20*cm, env_sizeZ = 20*cm;
   G4Material* env_mat = nist->FindOrBuildMaterial("G4_AIR");
    
-  // Option to switch on/off checking of volumes overlaps
+  // Volumes overlaps are not checked at placement, but once the whole
+  // geometry is built, see CheckOverlaps()
   //
-  G4bool checkOverlaps = true;
+  G4bool checkOverlaps = false;
 
   //     
   // World
@@ -126,6 +164,7 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
   G4double shape1_1_rmina =  0*cm, shape1_1_rmaxa = 4.5*cm;
   G4double shape1_1_rminb =  0*cm, shape1_1_rmaxb = 4.5*cm;
   G4double shape1_1_hz = 1.5*cm;
+  fCrystalFrontZ = pos1_1.z() - shape1_1_hz;
   G4double shape1_1_phimin = 0.*deg, shape1_1_phimax = 360.*deg;
   G4Cons* solidShape1_1 =    
     new G4Cons("Shape1_1", 
@@ -156,9 +195,10 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
   // Conical section shape       
   G4double shape1_2_rmina =  0*cm, shape1_2_rmaxa = 4.5*cm;
   G4double shape1_2_rminb =  0*cm, shape1_2_rmaxb = 4.5*cm;
-  G4double shape1_2_hz = 0.00005*cm;
+  G4double shape1_2_hz = 0.5*fDeadLayerThickness;
   G4double shape1_2_phimin = 0.*deg, shape1_2_phimax = 360.*deg;
-  G4ThreeVector pos1_2 = G4ThreeVector(0, 0*cm, 1.2-shape1_2_hz*cm);
+  // in contact with the front face of the crystal
+  G4ThreeVector pos1_2 = G4ThreeVector(0, 0*cm, fCrystalFrontZ-shape1_2_hz);
   G4Cons* solidShape1_2 =    
     new G4Cons("Shape1_2", 
     shape1_2_rmina, shape1_2_rmaxa, shape1_2_rminb, shape1_2_rmaxb, shape1_2_hz,
@@ -169,6 +209,8 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
                         shape1_2_mat,          //its material
                         "Shape1_2");           //its name
                
+  fDeadLayerSolid = solidShape1_2;
+  fDeadLayerPV =
   new G4PVPlacement(0,                       //no rotation
                     pos1_2,                    //at position
                     logicShape1_2,             //its logical volume
@@ -186,7 +228,7 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
   // Trapezoid shape      
   G4double shape2_rmina =  0*cm, shape2_rmaxa = 4.6*cm;
   G4double shape2_rminb =  0*cm, shape2_rmaxb = 4.6*cm;
-  G4double shape2_hz = 0.03*cm;
+  G4double shape2_hz = 0.5*fWindowThickness;
   G4double shape2_phimin = 0.*deg, shape2_phimax = 360.*deg;
    
   /*G4double shape2_dxa = 6*cm, shape2_dxb = 8*cm;
@@ -202,6 +244,8 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
                         shape2_mat,          //its material
                         "Shape2");           //its name
                
+  fWindowSolid = solidShape2;
+  fWindowPV =
   new G4PVPlacement(0,                       //no rotation
                     pos2,                    //at position
                     logicShape2,             //its logical volume
@@ -216,7 +260,7 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
   // Shape 3     Al frame
   //
   G4Material* shape3_mat = nist->FindOrBuildMaterial("G4_Al");
-  G4ThreeVector pos3 = G4ThreeVector(0*cm, 0*cm, 1.*cm);
+  G4ThreeVector pos3 = G4ThreeVector(0*cm, 0*cm, fFrameZ);
      
   G4double shape3_1rmina =  0.*cm, shape3_1rmaxa = 5.9*cm;
   G4double shape3_1rminb =  0.*cm, shape3_1rmaxb = 5.9*cm;
@@ -252,6 +296,7 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
                       shape3_mat,          //its material
                       "Shape3");           //its name
 
+  fFramePV =
   new G4PVPlacement(0,                       //no rotation
                     pos3,                    //at position
                     logicShape3,             //its logical volume
@@ -332,7 +377,7 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
   // Shape 6   half round Al shield
   //
   G4Material* shape6_mat = nist->FindOrBuildMaterial("G4_Al");
-  G4ThreeVector pos6 = G4ThreeVector(0*cm, 0*cm, 1.0*cm);
+  G4ThreeVector pos6 = G4ThreeVector(0*cm, 0*cm, fShieldZ);
   
   G4double shape6_rmina =  0*cm, shape6_rmaxa = 4.505*cm;
   G4double shape6_rminb =  0*cm, shape6_rmaxb = 4.505*cm;
@@ -352,6 +397,7 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
                         shape6_mat,          //its material
                         "Shape6");           //its name
                
+  fShieldPV =
   new G4PVPlacement(0,                       //no rotation
                     pos6,                    //at position
                     logicShape6,             //its logical volume
@@ -364,6 +410,16 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
 
   fScoringVolume = logicShape1_1;  //set Ge detector as ScoringVolume
 
+  // Regions with their own production cuts and step limits
+  //
+  DefineRegion("Crystal",   logicShape1_1);
+  DefineRegion("DeadLayer", logicShape1_2);
+  DefineRegion("Window",    logicShape2);
+  DefineRegion("Frame",     logicShape3);
+  DefineRegion("Frame",     logicShape6);
+
+  CheckOverlaps();
+
   //
   //always return the physical World
   //
@@ -371,3 +427,185 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::ConstructSDandField()
+{
+  // Sensitive detector on the Ge crystal.
+  // Called once per thread, each worker gets its own hits collection.
+  //
+  B1GeSD* geSD = new B1GeSD("B1/GeSD", "GeHitsCollection");
+  G4SDManager::GetSDMpointer()->AddNewDetector(geSD);
+  SetSensitiveDetector(fScoringVolume, geSD);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::DefineRegion(const G4String& regionName,
+                                          G4LogicalVolume* volume)
+{
+  G4Region* region =
+    G4RegionStore::GetInstance()->FindOrCreateRegion(regionName);
+  region->AddRootLogicalVolume(volume);
+  if ( ! region->GetProductionCuts() ) {
+    region->SetProductionCuts(new G4ProductionCuts());
+  }
+  ApplyRegionSettings(regionName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::ApplyRegionSettings(const G4String& regionName)
+{
+  // Nothing to do before the geometry is built: the values are picked up
+  // by DefineRegion()
+  G4Region* region =
+    G4RegionStore::GetInstance()->GetRegion(regionName, false);
+  if ( ! region || ! region->GetProductionCuts() ) return;
+
+  std::map<G4String, G4double>::const_iterator it = fRegionCuts.find(regionName);
+  if ( it != fRegionCuts.end() ) {
+    region->GetProductionCuts()->SetProductionCut(it->second);
+  }
+
+  it = fRegionStepMax.find(regionName);
+  if ( it != fRegionStepMax.end() ) {
+    if ( region->GetUserLimits() ) {
+      region->GetUserLimits()->SetMaxAllowedStep(it->second);
+    }
+    else {
+      region->SetUserLimits(new G4UserLimits(it->second));
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetRegionCut(const G4String& regionName,
+                                          G4double cut)
+{
+  // a modified G4ProductionCuts triggers the rebuild of the physics tables
+  // at the next run
+  fRegionCuts[regionName] = cut;
+  ApplyRegionSettings(regionName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetRegionStepMax(const G4String& regionName,
+                                              G4double stepMax)
+{
+  fRegionStepMax[regionName] = stepMax;
+  ApplyRegionSettings(regionName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetDeadLayerThickness(G4double thickness)
+{
+  fDeadLayerThickness = thickness;
+  UpdateGeometry();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetWindowThickness(G4double thickness)
+{
+  fWindowThickness = thickness;
+  UpdateGeometry();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetFramePosition(G4double z)
+{
+  fFrameZ = z;
+  UpdateGeometry();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetShieldPosition(G4double z)
+{
+  fShieldZ = z;
+  UpdateGeometry();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::UpdateGeometry()
+{
+  // before /run/initialize, Construct() picks up the new values
+  if ( ! fDeadLayerSolid ) return;
+
+  // The solids and placements are shared by all threads, which are idle
+  // between runs. Materials and regions are unchanged, so the physics
+  // tables stay valid; only the navigation voxels are rebuilt.
+  fDeadLayerSolid->SetZHalfLength(0.5*fDeadLayerThickness);
+  fDeadLayerPV->SetTranslation(
+    G4ThreeVector(0., 0., fCrystalFrontZ - 0.5*fDeadLayerThickness));
+  fWindowSolid->SetZHalfLength(0.5*fWindowThickness);
+  fFramePV->SetTranslation(G4ThreeVector(0., 0., fFrameZ));
+  fShieldPV->SetTranslation(G4ThreeVector(0., 0., fShieldZ));
+
+  CheckOverlaps();
+
+  G4RunManager::GetRunManager()->GeometryHasBeenModified();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String B1DetectorConstruction::GeometryHash() const
+{
+  // Everything the overlap check depends on: placements, solid
+  // dimensions (G4VSolid::StreamInfo) and the Geant4 version
+  std::ostringstream os;
+  os << std::setprecision(17) << G4VERSION_NUMBER << "\n";
+  G4PhysicalVolumeStore* store = G4PhysicalVolumeStore::GetInstance();
+  for (std::size_t i = 0; i < store->size(); ++i) {
+    const G4VPhysicalVolume* volume = (*store)[i];
+    os << volume->GetName() << " " << volume->GetCopyNo() << " "
+       << volume->GetTranslation() << " "
+       << (volume->GetMotherLogical() ? volume->GetMotherLogical()->GetName()
+                                      : G4String("-")) << "\n";
+    if (volume->GetRotation()) os << *volume->GetRotation() << "\n";
+    volume->GetLogicalVolume()->GetSolid()->StreamInfo(os);
+  }
+
+  return B1Hash::Fnv1a(os.str());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::CheckOverlaps()
+{
+  if (fOverlapCheckMode == kOverlapNever) return;
+
+  G4String hash;
+  if (fOverlapCheckMode == kOverlapCached) {
+    hash = GeometryHash();
+    std::ifstream cache(fOverlapCacheFile);
+    std::string line;
+    while (std::getline(cache, line)) {
+      if (line == hash) {
+        G4cout << "Overlap check skipped: geometry " << hash
+               << " already validated in " << fOverlapCacheFile << G4endl;
+        return;
+      }
+    }
+  }
+
+  G4bool overlaps = false;
+  G4PhysicalVolumeStore* store = G4PhysicalVolumeStore::GetInstance();
+  for (std::size_t i = 0; i < store->size(); ++i) {
+    if ((*store)[i]->CheckOverlaps()) overlaps = true;
+  }
+
+  // only a clean geometry is recorded, so that overlaps are reported
+  // again at the next start
+  if (fOverlapCheckMode == kOverlapCached && ! overlaps) {
+    std::ofstream cache(fOverlapCacheFile, std::ios::app);
+    if (cache) cache << hash << "\n";
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,279 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1DetectorMessenger.cc
+/// \brief Implementation of the B1DetectorMessenger class
+
+#include "B1DetectorMessenger.hh"
+#include "B1DetectorConstruction.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UImanager.hh"
+#include "G4Tokenizer.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <iomanip>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1DetectorMessenger::B1DetectorMessenger(B1DetectorConstruction* detector)
+ : G4UImessenger(),
+   fDetector(detector),
+   fDetDir(0),
+   fRegionCutCmd(0), fRegionStepMaxCmd(0),
+   fDeadLayerCmd(0), fWindowCmd(0), fFramePosCmd(0), fShieldPosCmd(0),
+   fScanCmd(0),
+   fOverlapModeCmd(0), fOverlapCacheCmd(0)
+{
+  fDetDir = new G4UIdirectory("/B1/det/");
+  fDetDir->SetGuidance("Detector construction control");
+
+  fRegionCutCmd = new G4UIcommand("/B1/det/regionCut",this);
+  fRegionCutCmd->SetGuidance("Set the production cut of a detector region.");
+  fRegionCutCmd->SetGuidance("Valid before and after /run/initialize; the world and");
+  fRegionCutCmd->SetGuidance("the envelope use the default cut (/run/setCut).");
+  G4UIparameter* regionPrm = new G4UIparameter("region",'s',false);
+  regionPrm->SetParameterCandidates("Crystal DeadLayer Window Frame");
+  fRegionCutCmd->SetParameter(regionPrm);
+  G4UIparameter* cutPrm = new G4UIparameter("cut",'d',false);
+  cutPrm->SetParameterRange("cut>0.");
+  fRegionCutCmd->SetParameter(cutPrm);
+  G4UIparameter* unitPrm = new G4UIparameter("unit",'s',true);
+  unitPrm->SetDefaultUnit("mm");
+  fRegionCutCmd->SetParameter(unitPrm);
+  fRegionCutCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fRegionCutCmd->SetToBeBroadcasted(false);
+
+  fRegionStepMaxCmd = new G4UIcommand("/B1/det/regionStepMax",this);
+  fRegionStepMaxCmd->SetGuidance("Limit the step length in a detector region.");
+  fRegionStepMaxCmd->SetGuidance("Needs the step limiter process of the physics list.");
+  regionPrm = new G4UIparameter("region",'s',false);
+  regionPrm->SetParameterCandidates("Crystal DeadLayer Window Frame");
+  fRegionStepMaxCmd->SetParameter(regionPrm);
+  G4UIparameter* stepPrm = new G4UIparameter("stepMax",'d',false);
+  stepPrm->SetParameterRange("stepMax>0.");
+  fRegionStepMaxCmd->SetParameter(stepPrm);
+  unitPrm = new G4UIparameter("unit",'s',true);
+  unitPrm->SetDefaultUnit("mm");
+  fRegionStepMaxCmd->SetParameter(unitPrm);
+  fRegionStepMaxCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fRegionStepMaxCmd->SetToBeBroadcasted(false);
+
+  fDeadLayerCmd = new G4UIcmdWithADoubleAndUnit("/B1/det/deadLayerThickness",this);
+  fDeadLayerCmd->SetGuidance("Set the thickness of the Ge dead layer (Shape1_2).");
+  fDeadLayerCmd->SetParameterName("thickness",false);
+  fDeadLayerCmd->SetRange("thickness>0.");
+  fDeadLayerCmd->SetUnitCategory("Length");
+  fDeadLayerCmd->SetDefaultUnit("um");
+  fDeadLayerCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fDeadLayerCmd->SetToBeBroadcasted(false);
+
+  fWindowCmd = new G4UIcmdWithADoubleAndUnit("/B1/det/windowThickness",this);
+  fWindowCmd->SetGuidance("Set the thickness of the carbon window (Shape2).");
+  fWindowCmd->SetParameterName("thickness",false);
+  fWindowCmd->SetRange("thickness>0.");
+  fWindowCmd->SetUnitCategory("Length");
+  fWindowCmd->SetDefaultUnit("mm");
+  fWindowCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fWindowCmd->SetToBeBroadcasted(false);
+
+  fFramePosCmd = new G4UIcmdWithADoubleAndUnit("/B1/det/framePosition",this);
+  fFramePosCmd->SetGuidance("Set the z position of the Al frame (Shape3).");
+  fFramePosCmd->SetParameterName("z",false);
+  fFramePosCmd->SetUnitCategory("Length");
+  fFramePosCmd->SetDefaultUnit("cm");
+  fFramePosCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fFramePosCmd->SetToBeBroadcasted(false);
+
+  fShieldPosCmd = new G4UIcmdWithADoubleAndUnit("/B1/det/shieldPosition",this);
+  fShieldPosCmd->SetGuidance("Set the z position of the Al shield (Shape6).");
+  fShieldPosCmd->SetParameterName("z",false);
+  fShieldPosCmd->SetUnitCategory("Length");
+  fShieldPosCmd->SetDefaultUnit("cm");
+  fShieldPosCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fShieldPosCmd->SetToBeBroadcasted(false);
+
+  fScanCmd = new G4UIcommand("/B1/det/scan",this);
+  fScanCmd->SetGuidance("Run nEvents for each value of a geometry parameter.");
+  fScanCmd->SetGuidance("The geometry is modified in place between the runs,");
+  fScanCmd->SetGuidance("the output of each run goes to");
+  fScanCmd->SetGuidance("B1scan_<parameter>_<value><unit>.");
+  fScanCmd->SetGuidance("e.g. /B1/det/scan deadLayerThickness um 100000 0.5 1 2 5");
+  G4UIparameter* parameterPrm = new G4UIparameter("parameter",'s',false);
+  parameterPrm->SetParameterCandidates(
+    "deadLayerThickness windowThickness framePosition shieldPosition");
+  fScanCmd->SetParameter(parameterPrm);
+  unitPrm = new G4UIparameter("unit",'s',false);
+  fScanCmd->SetParameter(unitPrm);
+  G4UIparameter* eventsPrm = new G4UIparameter("nEvents",'i',false);
+  eventsPrm->SetParameterRange("nEvents>0");
+  fScanCmd->SetParameter(eventsPrm);
+  G4UIparameter* valuesPrm = new G4UIparameter("values",'s',false);
+  fScanCmd->SetParameter(valuesPrm);
+  fScanCmd->AvailableForStates(G4State_Idle);
+  fScanCmd->SetToBeBroadcasted(false);
+
+  fOverlapModeCmd = new G4UIcmdWithAString("/B1/det/overlapCheck",this);
+  fOverlapModeCmd->SetGuidance("Check of the volumes overlaps:");
+  fOverlapModeCmd->SetGuidance("  always : at each construction or change");
+  fOverlapModeCmd->SetGuidance("  cached : skipped for a geometry already found valid");
+  fOverlapModeCmd->SetGuidance("           (hash listed in /B1/det/overlapCache)");
+  fOverlapModeCmd->SetGuidance("  never  : no check");
+  fOverlapModeCmd->SetParameterName("mode",false);
+  fOverlapModeCmd->SetCandidates("always cached never");
+  fOverlapModeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fOverlapModeCmd->SetToBeBroadcasted(false);
+
+  fOverlapCacheCmd = new G4UIcmdWithAString("/B1/det/overlapCache",this);
+  fOverlapCacheCmd->SetGuidance("Set the file of the validated geometry hashes.");
+  fOverlapCacheCmd->SetParameterName("fileName",false);
+  fOverlapCacheCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fOverlapCacheCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1DetectorMessenger::~B1DetectorMessenger()
+{
+  delete fOverlapCacheCmd;
+  delete fOverlapModeCmd;
+  delete fScanCmd;
+  delete fShieldPosCmd;
+  delete fFramePosCmd;
+  delete fWindowCmd;
+  delete fDeadLayerCmd;
+  delete fRegionStepMaxCmd;
+  delete fRegionCutCmd;
+  delete fDetDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fRegionCutCmd || command == fRegionStepMaxCmd) {
+    G4Tokenizer next(newValue);
+    G4String regionName = next();
+    G4double value = G4UIcommand::ConvertToDouble(next());
+    G4String unit = next();
+    value *= G4UIcommand::ValueOf(unit);
+
+    if (command == fRegionCutCmd) fDetector->SetRegionCut(regionName, value);
+    else                          fDetector->SetRegionStepMax(regionName, value);
+  }
+
+  if (command == fDeadLayerCmd) {
+    fDetector->SetDeadLayerThickness(fDeadLayerCmd->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fWindowCmd) {
+    fDetector->SetWindowThickness(fWindowCmd->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fFramePosCmd) {
+    fDetector->SetFramePosition(fFramePosCmd->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fShieldPosCmd) {
+    fDetector->SetShieldPosition(fShieldPosCmd->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fScanCmd) Scan(newValue);
+
+  if (command == fOverlapModeCmd) {
+    if (newValue == "always")
+      fDetector->SetOverlapCheckMode(B1DetectorConstruction::kOverlapAlways);
+    else if (newValue == "never")
+      fDetector->SetOverlapCheckMode(B1DetectorConstruction::kOverlapNever);
+    else
+      fDetector->SetOverlapCheckMode(B1DetectorConstruction::kOverlapCached);
+  }
+
+  if (command == fOverlapCacheCmd) {
+    fDetector->SetOverlapCacheFile(newValue);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String B1DetectorMessenger::GetCurrentValue(G4UIcommand* command)
+{
+  // full precision, so that the scan restores the value exactly
+  G4double value = 0.;
+  if (command == fDeadLayerCmd)      value = fDetector->GetDeadLayerThickness();
+  else if (command == fWindowCmd)    value = fDetector->GetWindowThickness();
+  else if (command == fFramePosCmd)  value = fDetector->GetFramePosition();
+  else if (command == fShieldPosCmd) value = fDetector->GetShieldPosition();
+  else return "";
+
+  std::ostringstream os;
+  os << std::setprecision(17) << value/mm << " mm";
+  return os.str();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorMessenger::Scan(const G4String& newValue)
+{
+  G4Tokenizer next(newValue);
+  G4String parameter = next();
+  G4String unit = next();
+  G4String nofEvents = next();
+
+  // The commands go through the UI manager, so that the output file name
+  // is broadcast to the workers like a macro command. The parameter and
+  // the output file name are restored afterwards, so that a later run
+  // does not overwrite the file of the last scan point.
+  G4UImanager* UImanager = G4UImanager::GetUIpointer();
+  G4String savedValue = UImanager->GetCurrentValues("/B1/det/" + parameter);
+  G4String savedFileName = UImanager->GetCurrentValues("/B1/output/fileName");
+
+  G4String value;
+  while ( ! (value = next()).empty() ) {
+    std::ostringstream fileName;
+    fileName << "B1scan_" << parameter << "_" << value << unit;
+
+    if (UImanager->ApplyCommand("/B1/det/" + parameter + " " + value + " " + unit)
+        != fCommandSucceeded) {
+      G4ExceptionDescription msg;
+      msg << "Cannot set " << parameter << " to " << value << " " << unit
+          << ", scan stopped.";
+      G4Exception("B1DetectorMessenger::Scan()","B1Scan0001",JustWarning,msg);
+      break;
+    }
+    UImanager->ApplyCommand("/B1/output/fileName " + fileName.str());
+    UImanager->ApplyCommand("/run/beamOn " + nofEvents);
+  }
+
+  UImanager->ApplyCommand("/B1/det/" + parameter + " " + savedValue);
+  UImanager->ApplyCommand("/B1/output/fileName " + savedFileName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
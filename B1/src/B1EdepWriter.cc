@@ -0,0 +1,193 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1EdepWriter.cc
+/// \brief Implementation of the B1EdepWriter class
+
+#include "B1EdepWriter.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace {
+  // 64 MB pages: 16M records per page
+  const std::size_t kPageBytes = std::size_t(64) << 20;
+
+  // a JSON string value: quotes, backslashes and control characters escaped
+  std::string JsonString(const G4String& value)
+  {
+    std::string result("\"");
+    for (std::size_t i = 0; i < value.size(); ++i) {
+      unsigned char c = value[i];
+      if (c == '"' || c == '\\') {
+        result += '\\';
+        result += c;
+      }
+      else if (c < 0x20) {
+        char code[8];
+        std::snprintf(code, sizeof(code), "\\u%04x", c);
+        result += code;
+      }
+      else result += c;
+    }
+    result += '"';
+    return result;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EdepWriter::B1EdepWriter()
+ : fFileName(""),
+   fColumn(""),
+   fUnit(""),
+   fFd(-1),
+   fPage(0),
+   fPageIndex(0),
+   fPagePos(0),
+   fPageRecords(kPageBytes/sizeof(G4float)),
+   fNofRecords(0),
+   fNofEvents(0)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EdepWriter::~B1EdepWriter()
+{
+  Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1EdepWriter::Open(const G4String& fileName,
+                          const G4String& column, const G4String& unit)
+{
+  Close();
+
+  fFd = ::open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fFd < 0) {
+    G4cerr << "\n---> B1EdepWriter::Open(): cannot open " << fileName
+           << ": " << std::strerror(errno) << G4endl;
+    return false;
+  }
+
+  fFileName = fileName;
+  fColumn = column;
+  fUnit = unit;
+  fNofRecords = 0;
+  fNofEvents = 0;
+  fPageIndex = 0;
+  // no page mapped yet, the first Append() maps page 0
+  fPage = 0;
+  fPagePos = fPageRecords;
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1EdepWriter::MapNextPage()
+{
+  if (fFd < 0) return false;
+
+  if (fPage) {
+    UnmapPage();
+    ++fPageIndex;
+  }
+
+  // extend the file by one page and map it
+  off_t offset = off_t(fPageIndex*kPageBytes);
+  if (::ftruncate(fFd, offset + off_t(kPageBytes)) != 0) {
+    G4cerr << "\n---> B1EdepWriter: cannot extend " << fFileName
+           << ": " << std::strerror(errno) << G4endl;
+    Close();
+    return false;
+  }
+  void* addr = ::mmap(0, kPageBytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      fFd, offset);
+  if (addr == MAP_FAILED) {
+    G4cerr << "\n---> B1EdepWriter: cannot map " << fFileName
+           << ": " << std::strerror(errno) << G4endl;
+    Close();
+    return false;
+  }
+  fPage = static_cast<G4float*>(addr);
+  fPagePos = 0;
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EdepWriter::UnmapPage()
+{
+  if (! fPage) return;
+  ::munmap(fPage, kPageBytes);
+  fPage = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EdepWriter::Close()
+{
+  if (fFd < 0) return;
+
+  UnmapPage();
+
+  // drop the unused tail of the last page
+  if (::ftruncate(fFd, off_t(fNofRecords*sizeof(G4float))) != 0) {
+    G4cerr << "\n---> B1EdepWriter: cannot truncate " << fFileName
+           << ": " << std::strerror(errno) << G4endl;
+  }
+  ::close(fFd);
+  fFd = -1;
+
+  WriteManifest();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EdepWriter::WriteManifest() const
+{
+  const unsigned short probe = 1;
+  const char* byteOrder 
+    = *reinterpret_cast<const unsigned char*>(&probe) ? "little" : "big";
+
+  std::ofstream manifest((fFileName + ".json").c_str());
+  manifest << "{\n"
+           << "  \"file\": " << JsonString(fFileName) << ",\n"
+           << "  \"dtype\": \"float32\",\n"
+           << "  \"byteorder\": \"" << byteOrder << "\",\n"
+           << "  \"unit\": " << JsonString(fUnit) << ",\n"
+           << "  \"column\": " << JsonString(fColumn) << ",\n"
+           << "  \"records\": " << fNofRecords << ",\n"
+           << "  \"events\": " << fNofEvents << "\n"
+           << "}\n";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -29,39 +29,148 @@
 
 #include "B1EventAction.hh"
 #include "B1RunAction.hh"
+#include "B1EventMessenger.hh"
 #include "B1HistoManager.hh"
+#include "B1Profiler.hh"
+#include "B1GeHit.hh"
+#include "B1EventInformation.hh"
+#include "B1HistoryTree.hh"
 
 #include "G4Event.hh"
 #include "G4RunManager.hh"
+#include "G4SDManager.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-B1EventAction::B1EventAction(B1RunAction* runAction, HistoManager* histo)
+B1EventAction::B1EventAction(B1RunAction* runAction, HistoManager* histo,
+                             B1Profiler* profiler, B1HistoryTree* history)
 : G4UserEventAction(),
-  fRunAction(runAction),fHistoManager(histo),
-  fEdep(0.)
-{} 
+  fRunAction(runAction),fHistoManager(histo),fProfiler(profiler),
+  fHistory(history),
+  fMessenger(0),
+  fEdep(0.),
+  fThreshold(0.),
+  fGeHCID(-1)
+{
+  fMessenger = new B1EventMessenger(this);
+} 
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1EventAction::~B1EventAction()
-{}
+{
+  delete fHistory;
+  delete fMessenger;
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 void B1EventAction::BeginOfEventAction(const G4Event*)
 {    
   fEdep = 0.;
+  fHistory->Reset();
+  fProfiler->Mark(B1Profiler::kGeneration);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void B1EventAction::EndOfEventAction(const G4Event*)
+void B1EventAction::EndOfEventAction(const G4Event* event)
 {   
+  fProfiler->Mark(B1Profiler::kTracking);
+
+  // Get hits collection ID (only once)
+  if (fGeHCID < 0) {
+    fGeHCID = G4SDManager::GetSDMpointer()->GetCollectionID("GeHitsCollection");
+  }
+
+  // sum the energy deposit in the Ge crystal, and per history branch
+  // under importance sampling
+  G4HCofThisEvent* hce = event->GetHCofThisEvent();
+  B1GeHitsCollection* geHC
+    = hce ? static_cast<B1GeHitsCollection*>(hce->GetHC(fGeHCID)) : 0;
+  G4bool split = fHistory->GetNofNodes() > 0;
+  if (geHC) {
+    std::size_t nofHits = geHC->entries();
+    for (std::size_t i = 0; i < nofHits; ++i) {
+      const B1GeHit* hit = (*geHC)[i];
+      fEdep += hit->GetEdep();
+      if (split) fHistory->AddEdep(hit->GetBranch(), hit->GetEdep());
+    }
+  }
+
+  // event weight: the weight of the primary (line source) times the
+  // product of the weights of the biased decays, whichever hit they made
+  const B1EventInformation* info
+    = static_cast<const B1EventInformation*>(event->GetUserInformation());
+  G4double weight = 1.;
+  const G4PrimaryVertex* vertex = event->GetPrimaryVertex();
+  if (vertex) {
+    weight = vertex->GetWeight();
+    if (vertex->GetPrimary()) weight *= vertex->GetPrimary()->GetWeight();
+  }
+  if (info) weight *= info->GetDecayWeight();
+
+  // score the event, or each weighted alternative of its split history
+  G4bool triggered = false;
+  G4double meanEdep = fEdep;
+  if (! split) {
+    fProfiler->Mark(B1Profiler::kScoring);
+    triggered = Score(info, fEdep, weight, true);
+  }
+  else {
+    fHistory->Resolve();
+    fProfiler->Mark(B1Profiler::kScoring);
+    meanEdep = 0.;
+    for (std::size_t i = 0; i < fHistory->GetNofAlternatives(); ++i) {
+      G4double edep = fHistory->GetEdep(i);
+      meanEdep += fHistory->GetWeight(i)*edep;
+      if (Score(info, edep, weight*fHistory->GetWeight(i), i == 0)) {
+        triggered = true;
+      }
+    }
+  }
+  fProfiler->Mark(B1Profiler::kFill);
+
+  // the trigger count and the scan scheduler take one value per event
+  if (triggered) fRunAction->CountTriggered();
+  if (info && info->GetPoint() >= 0) {
+    fRunAction->AddScanEdep(info->GetPoint(), meanEdep, weight);
+  }
+
+  fRunAction->EndEvent();
+
+  // stop the run once the precision target or the scan target is reached
+  fRunAction->CheckStop();
+
+  fProfiler->EndEvent();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1EventAction::Score(const B1EventInformation* info, G4double edep,
+                            G4double weight, G4bool newEvent)
+{
   // accumulate statistics in run action
-  fRunAction->AddEdep(fEdep);
-  fHistoManager->FillHisto(0, fEdep);
-  fHistoManager->FillNtuple(fEdep);
+  fRunAction->AddEdep(edep, weight);
+
+  // source position scan: score the event for its point
+  G4bool triggered = edep > fThreshold;
+  if (info && info->GetPoint() >= 0) {
+    fHistoManager->FillScan(info->GetPoint(), edep, weight, triggered,
+                            newEvent);
+  }
+
+  // trigger: events below threshold are only counted in the run action
+  if (! triggered) return false;
+
+  fHistoManager->FillHisto(0, edep, weight);
+  fHistoManager->FillSpectra(edep, weight);
+  fHistoManager->FillFolded(edep, weight);
+  fHistoManager->FillNtuple(edep, weight);
+  return true;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,74 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1EventMessenger.cc
+/// \brief Implementation of the B1EventMessenger class
+
+#include "B1EventMessenger.hh"
+#include "B1EventAction.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EventMessenger::B1EventMessenger(B1EventAction* eventAction)
+ : G4UImessenger(),
+   fEventAction(eventAction),
+   fScoreDir(0),
+   fThresholdCmd(0)
+{
+  fScoreDir = new G4UIdirectory("/B1/score/");
+  fScoreDir->SetGuidance("Event scoring control");
+
+  fThresholdCmd = new G4UIcmdWithADoubleAndUnit("/B1/score/threshold",this);
+  fThresholdCmd->SetGuidance("Set the trigger threshold on the Edep in Ge.");
+  fThresholdCmd->SetGuidance("Events with Edep <= threshold are counted but");
+  fThresholdCmd->SetGuidance("neither histogrammed nor written out.");
+  fThresholdCmd->SetParameterName("threshold",false);
+  fThresholdCmd->SetRange("threshold>=0.");
+  fThresholdCmd->SetUnitCategory("Energy");
+  fThresholdCmd->SetDefaultUnit("keV");
+  fThresholdCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EventMessenger::~B1EventMessenger()
+{
+  delete fThresholdCmd;
+  delete fScoreDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fThresholdCmd) {
+    fEventAction->SetThreshold(fThresholdCmd->GetNewDoubleValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,102 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1GeHit.cc
+/// \brief Implementation of the B1GeHit class
+
+#include "B1GeHit.hh"
+#include "G4UnitsTable.hh"
+
+#include <iomanip>
+
+G4ThreadLocal G4Allocator<B1GeHit>* B1GeHitAllocator = 0;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1GeHit::B1GeHit()
+ : G4VHit(),
+   fTrackID(-1),
+   fEdep(0.),
+   fTime(0.),
+   fPos(G4ThreeVector()),
+   fWeight(1.),
+   fBranch(0)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1GeHit::~B1GeHit() {}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1GeHit::B1GeHit(const B1GeHit& right)
+  : G4VHit()
+{
+  fTrackID   = right.fTrackID;
+  fEdep      = right.fEdep;
+  fTime      = right.fTime;
+  fPos       = right.fPos;
+  fWeight    = right.fWeight;
+  fBranch    = right.fBranch;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const B1GeHit& B1GeHit::operator=(const B1GeHit& right)
+{
+  fTrackID   = right.fTrackID;
+  fEdep      = right.fEdep;
+  fTime      = right.fTime;
+  fPos       = right.fPos;
+  fWeight    = right.fWeight;
+  fBranch    = right.fBranch;
+
+  return *this;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1GeHit::operator==(const B1GeHit& right) const
+{
+  return ( this == &right ) ? true : false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1GeHit::Print()
+{
+  G4cout
+     << "  trackID: " << fTrackID
+     << " Edep: "
+     << std::setw(7) << G4BestUnit(fEdep,"Energy")
+     << " Time: "
+     << std::setw(7) << G4BestUnit(fTime,"Time")
+     << " Position: "
+     << std::setw(7) << G4BestUnit(fPos,"Length")
+     << " Weight: " << fWeight
+     << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
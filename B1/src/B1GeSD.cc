@@ -0,0 +1,97 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1GeSD.cc
+/// \brief Implementation of the B1GeSD class
+
+#include "B1GeSD.hh"
+#include "B1TrackInformation.hh"
+
+#include "G4HCofThisEvent.hh"
+#include "G4Step.hh"
+#include "G4SDManager.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1GeSD::B1GeSD(const G4String& name,
+               const G4String& hitsCollectionName) 
+ : G4VSensitiveDetector(name),
+   fHitsCollection(0),
+   fHCID(-1),
+   fReservedHits(64)
+{
+  collectionName.insert(hitsCollectionName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1GeSD::~B1GeSD() 
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1GeSD::Initialize(G4HCofThisEvent* hce)
+{
+  // Create hits collection
+  fHitsCollection 
+    = new B1GeHitsCollection(SensitiveDetectorName, collectionName[0]);
+  fHitsCollection->GetVector()->reserve(fReservedHits);
+
+  // Add this collection in hce
+  if (fHCID < 0) {
+    fHCID = G4SDManager::GetSDMpointer()->GetCollectionID(fHitsCollection);
+  }
+  hce->AddHitsCollection(fHCID, fHitsCollection);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1GeSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+  // energy deposit
+  G4double edep = step->GetTotalEnergyDeposit();
+  if (edep == 0.) return false;
+
+  const G4StepPoint* postStepPoint = step->GetPostStepPoint();
+
+  B1GeHit* newHit = new B1GeHit();
+  newHit->SetTrackID(step->GetTrack()->GetTrackID());
+  newHit->SetWeight(step->GetTrack()->GetWeight());
+  newHit->SetBranch(B1TrackInformation::GetBranch(step->GetTrack()));
+  newHit->SetEdep(edep);
+  newHit->SetTime(postStepPoint->GetGlobalTime());
+  newHit->SetPos(postStepPoint->GetPosition());
+
+  fHitsCollection->insert(newHit);
+
+  // keep the reserve in line with the busiest event seen so far
+  if (fHitsCollection->entries() > fReservedHits) {
+    fReservedHits = fHitsCollection->entries();
+  }
+
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -1,17 +1,43 @@
 #include "B1HistoManager.hh"
+#include "B1HistoMessenger.hh"
+#include "B1EdepWriter.hh"
+#include "B1RunSummary.hh"
+#include "B1ScanGrid.hh"
 #include "G4UnitsTable.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 HistoManager::HistoManager()
- : fFactoryOn(false)
-{}
+ : fFactoryOn(false),
+   fMessenger(0), fFileName("B1out"), fSummaryFileName(""),
+   fOutputFormat(kRoot), fEdepWriter(0),
+   fWeightWriter(0), fNofEvents(0),
+   fNbins(1000), fEmin(4.0*keV), fEmax(30.0*keV), fInvBinWidth(0.),
+   fFoldingMode(kFoldOff),
+   fScanGrid(0), fScanH2Id(-1), fScanEventsId(-1),
+   fNtupleFlushSize(1 << 20)
+{
+  fInvBinWidth = fNbins/(fEmax - fEmin);
+  fBins.resize(2, std::vector<BinData>(fNbins + 2));
+
+  fMessenger = new HistoMessenger(this);
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 HistoManager::~HistoManager()
-{}
+{
+  delete fWeightWriter;
+  delete fEdepWriter;
+  delete fMessenger;
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 void HistoManager::Book()
@@ -21,17 +47,24 @@ void HistoManager::Book()
   // in HistoManager.hh
   G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
   analysisManager->SetVerboseLevel(1);
-  // Only merge in MT mode to avoid warning when running in Sequential mode
+  // Only merge in MT mode to avoid warning when running in Sequential mode.
+  // The binary output has no ntuple, each thread writes its own file.
 #ifdef G4MULTITHREADED
-  analysisManager->SetNtupleMerging(true);
+  analysisManager->SetNtupleMerging(fOutputFormat == kRoot);
 #endif
 
   // Create directories
   analysisManager->SetHistoDirectoryName("histo");
 
+  // no scan histograms nor extra spectra until booked
+  fScanH2Id = fScanEventsId = -1;
+  fScanBins.clear();
+  fScanEvents.clear();
+  for (std::size_t is = 0; is < fSpectra.size(); ++is) fSpectra[is].fH1Id = -1;
+
   // Open an output file
   //
-  G4bool fileOpen = analysisManager->OpenFile("B1out");
+  G4bool fileOpen = analysisManager->OpenFile(fFileName);
   if (! fileOpen) {
     G4cerr << "\n---> HistoManager::Book(): cannot open "
            << analysisManager->GetFileName() << G4endl;
@@ -44,12 +77,82 @@ void HistoManager::Book()
   // analysisManager->SetFirstHistoId(1);
 
   // id = 0
-  analysisManager->CreateH1("ESpec","Edep in Ge (keV)", 1000, 4.0*keV, 30.0*keV);
+  analysisManager->CreateH1("ESpec","Edep in Ge (keV)", fNbins, fEmin, fEmax);
+
+  // id = 1
+  if (fFoldingMode != kFoldOff) {
+    analysisManager->CreateH1("ESpecFolded","Edep in Ge with resolution (keV)",
+                              fNbins, fEmin, fEmax);
+  }
+
+  // spectra defined with /B1/histo/addSpectrum
+  for (std::size_t is = 0; is < fSpectra.size(); ++is) {
+    Spectrum& spectrum = fSpectra[is];
+    spectrum.fH1Id = analysisManager->CreateH1(spectrum.fName,
+      "Edep in Ge (keV)", spectrum.fNbins, spectrum.fEmin, spectrum.fEmax,
+      "none", "none", spectrum.fLog ? "log" : "linear");
+    tools::histo::h1d* h1 = analysisManager->GetH1(spectrum.fH1Id, false);
+    if (h1 && spectrum.fLog) spectrum.fEdges = h1->axis().edges();
+  }
+
+  // source position scan: one ESpec row per point
+  if (fScanGrid && fScanGrid->IsActive()) {
+    G4int nofPoints = fScanGrid->GetNofPoints();
+    fScanH2Id = analysisManager->CreateH2("ESpecScan",
+      "Edep in Ge per scan point (keV)",
+      nofPoints, -0.5, nofPoints - 0.5, fNbins, fEmin, fEmax);
+    fScanEventsId = analysisManager->CreateH1("ScanEvents",
+      "Events per scan point", nofPoints, -0.5, nofPoints - 0.5);
+    ScanBin empty = { 0, 0., 0. };
+    fScanBins.assign(std::size_t(nofPoints)*(fNbins + 2), empty);
+    fScanEvents.assign(nofPoints, 0);
+  }
   
-  analysisManager->CreateNtuple("B1", "Edep in Ge (keV)");
-  analysisManager->CreateNtupleDColumn("ESpec");
-  analysisManager->FinishNtuple();
+  if (fOutputFormat == kRoot) {
+    analysisManager->CreateNtuple("B1", "Edep in Ge (keV)");
+    analysisManager->CreateNtupleDColumn("ESpec");
+    analysisManager->CreateNtupleDColumn("Weight");
+    analysisManager->FinishNtuple();
+  }
+  else if (fOutputFormat == kBinary &&
+           (G4Threading::IsWorkerThread() ||
+            ! G4Threading::IsMultithreadedApplication())) {
+    // the master of an MT run processes no events and writes no file
+    G4String binaryName = fFileName;
+    if (G4Threading::IsWorkerThread()) {
+      std::ostringstream os;
+      os << "_t" << G4Threading::G4GetThreadId();
+      binaryName += os.str();
+    }
+    binaryName += ".f32";
+    if (! fEdepWriter) fEdepWriter = new B1EdepWriter();
+    if (! fEdepWriter->Open(binaryName)) {
+      // no binary output for this run
+      delete fEdepWriter;
+      fEdepWriter = 0;
+      G4ExceptionDescription msg;
+      msg << "Cannot open " << binaryName
+          << ", the per-event Edep is not written out in this run.";
+      G4Exception("HistoManager::Book()", "B1Histo0002", JustWarning, msg);
+    }
+    // weight file, opened on the first weighted event
+    delete fWeightWriter;
+    fWeightWriter = 0;
+  }
   
+  // reset the per-thread buffers
+  BinData empty = { 0, 0., 0., 0., 0. };
+  for (std::size_t id = 0; id < fBins.size(); ++id) {
+    std::fill(fBins[id].begin(), fBins[id].end(), empty);
+  }
+  for (std::size_t is = 0; is < fSpectra.size(); ++is) {
+    fSpectra[is].fBins.assign(fSpectra[is].fNbins + 2, empty);
+  }
+  fNtupleESpec.clear();
+  fNtupleESpec.reserve(fNtupleFlushSize);
+  fNtupleWeight.clear();
+  fNtupleWeight.reserve(fNtupleFlushSize);
+
   fFactoryOn = true;
 
   G4cout << "\n----> Output file is open in "
@@ -63,6 +166,26 @@ void HistoManager::Save()
 {
   if (! fFactoryOn) return;
 
+  // hand the per-thread buffers over to the analysis manager
+  ReduceHisto();
+  ReduceScan();
+  FlushNtuple();
+
+  if (fEdepWriter && fEdepWriter->IsOpen()) {
+    fEdepWriter->SetNofEvents(fNofEvents);
+    fEdepWriter->Close();
+    G4cout << "\n----> " << fEdepWriter->GetNofRecords()
+           << " Edep records (" << fNofEvents << " events) written in "
+           << fEdepWriter->GetFileName() << G4endl;
+  }
+  if (fWeightWriter && fWeightWriter->IsOpen()) {
+    fWeightWriter->SetNofEvents(fNofEvents);
+    fWeightWriter->Close();
+  }
+
+  // the sparse spectra are merged as accumulables
+  if (! G4Threading::IsWorkerThread()) fSparseSpectra.Write(fFileName);
+
   G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
   analysisManager->Write();
   analysisManager->CloseFile();
@@ -75,19 +198,252 @@ void HistoManager::Save()
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void HistoManager::FillSummary(B1RunSummary& summary)
+{
+  if (! fFactoryOn) return;
+
+  // ReduceHisto() copies the bins, so Save() can call it again
+  ReduceHisto();
+
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  std::vector<G4int> ids;
+  ids.push_back(0);
+  if (fFoldingMode != kFoldOff) ids.push_back(1);
+  for (std::size_t is = 0; is < fSpectra.size(); ++is) {
+    ids.push_back(fSpectra[is].fH1Id);
+  }
+  for (std::size_t n = 0; n < ids.size(); ++n) {
+    tools::histo::h1d* h1 = analysisManager->GetH1(ids[n], false);
+    if (! h1) continue;
+    summary.AddHisto(analysisManager->GetH1Name(ids[n]),
+                     analysisManager->GetH1Title(ids[n]), *h1);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoManager::AddSpectrum(const G4String& name, G4int nbins,
+                               G4double emin, G4double emax, G4bool logBins)
+{
+  if (nbins < 1 || emax <= emin || (logBins && emin <= 0.)) {
+    G4ExceptionDescription msg;
+    msg << "Invalid binning of spectrum " << name << ", ignored";
+    G4Exception("HistoManager::AddSpectrum()", "B1Histo0001", JustWarning, msg);
+    return;
+  }
+
+  Spectrum spectrum;
+  spectrum.fName = name;
+  spectrum.fNbins = nbins;
+  spectrum.fEmin = emin;
+  spectrum.fEmax = emax;
+  spectrum.fLog = logBins;
+  spectrum.fInvBinWidth = nbins/(emax - emin);
+  spectrum.fH1Id = -1;
+  fSpectra.push_back(spectrum);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoManager::AddSparseSpectrum(const G4String& name, G4double binWidth,
+                                     G4double emin, G4double emax)
+{
+  if (binWidth <= 0. || emax <= emin) {
+    G4ExceptionDescription msg;
+    msg << "Invalid binning of sparse spectrum " << name << ", ignored";
+    G4Exception("HistoManager::AddSparseSpectrum()", "B1Histo0001",
+                JustWarning, msg);
+    return;
+  }
+  fSparseSpectra.AddSpectrum(name, binWidth, emin, emax);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoManager::ClearSpectra()
+{
+  fSpectra.clear();
+  fSparseSpectra.Clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 void HistoManager::FillHisto(G4int ih, G4double xbin, G4double weight)
 {
+  if (ih < 0 || ih >= G4int(fBins.size())) {
+    G4AnalysisManager::Instance()->FillH1(ih, xbin, weight);
+    return;
+  }
+
+  G4int i;
+  if (xbin < fEmin)       i = 0;
+  else if (xbin >= fEmax) i = fNbins + 1;
+  else                    i = 1 + G4int((xbin - fEmin)*fInvBinWidth);
+  if (i > fNbins + 1) i = fNbins + 1;
+
+  BinData& bin = fBins[ih][i];
+  bin.fEntries++;
+  bin.fSw   += weight;
+  bin.fSw2  += weight*weight;
+  bin.fSxw  += xbin*weight;
+  bin.fSx2w += xbin*xbin*weight;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoManager::FillNtuple(G4double energy, G4double weight)
+{
+  if (fOutputFormat == kNone) return;
+
+  if (fOutputFormat == kBinary) {
+    if (! fEdepWriter || ! fEdepWriter->IsOpen()) return;
+    if (weight != 1. && ! fWeightWriter) {
+      // first weighted event: the previous records all had weight 1
+      G4String weightName = fEdepWriter->GetFileName();
+      weightName.insert(weightName.size() - 4, "_weight");   // before .f32
+      fWeightWriter = new B1EdepWriter();
+      if (fWeightWriter->Open(weightName, "Weight", "1")) {
+        for (std::size_t i = 0; i < fEdepWriter->GetNofRecords(); ++i) {
+          fWeightWriter->Append(1.f);
+        }
+      }
+    }
+    fEdepWriter->Append(G4float(energy/keV));
+    if (fWeightWriter) fWeightWriter->Append(G4float(weight));
+    return;
+  }
+
+  fNtupleESpec.push_back(energy);
+  fNtupleWeight.push_back(weight);
+
+  // bound the memory used by very long runs
+  if (fNtupleESpec.size() >= fNtupleFlushSize) FlushNtuple();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoManager::FillFolded(G4double energy, G4double weight)
+{
+  if (fFoldingMode == kFoldOff) return;
+
+  FillHisto(1, fFolder.Fold(energy), weight);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoManager::ReduceHisto()
+{
+  // The histograms are booked empty at each run, so the local bins
+  // are copied over rather than added.
+  CopyBins(0, fBins[0]);
+  if (fFoldingMode != kFoldOff) CopyBins(1, fBins[1]);
+  for (std::size_t is = 0; is < fSpectra.size(); ++is) {
+    CopyBins(fSpectra[is].fH1Id, fSpectra[is].fBins);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoManager::CopyBins(G4int id, const std::vector<BinData>& bins)
+{
+  tools::histo::h1d* h1 = G4AnalysisManager::Instance()->GetH1(id, false);
+  if (! h1) return;
+
+  for (std::size_t i = 0; i < bins.size(); ++i) {
+    const BinData& bin = bins[i];
+    if (bin.fEntries == 0) continue;
+    h1->set_bin_content(i, bin.fEntries, bin.fSw, bin.fSw2,
+                        bin.fSxw, bin.fSx2w);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoManager::ReduceScan()
+{
+  if (fScanH2Id < 0) return;
+
   G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
-  analysisManager->FillH1(ih, xbin, weight);
+  tools::histo::h2d* h2 = analysisManager->GetH2(fScanH2Id, false);
+  tools::histo::h1d* h1 = analysisManager->GetH1(fScanEventsId, false);
+  if (! h2 || ! h1) return;
+
+  // copied, as in ReduceHisto(); the y moments use the bin centres
+  for (std::size_t point = 0; point < fScanEvents.size(); ++point) {
+    G4double x = point;
+    G4double n = fScanEvents[point];
+    if (n > 0.) {
+      h1->set_bin_content(point + 1, fScanEvents[point], n, n, x*n, x*x*n);
+    }
+    for (G4int i = 0; i < fNbins + 2; ++i) {
+      const ScanBin& bin = fScanBins[point*(fNbins + 2) + i];
+      if (bin.fEntries == 0) continue;
+      G4double y;
+      if (i == 0)               y = fEmin;
+      else if (i == fNbins + 1) y = fEmax;
+      else                      y = fEmin + (i - 0.5)/fInvBinWidth;
+      h2->set_bin_content(point + 1, i, bin.fEntries, bin.fSw, bin.fSw2,
+                          x*bin.fSw, x*x*bin.fSw, y*bin.fSw, y*y*bin.fSw);
+    }
+  }
 }
 
-void HistoManager::FillNtuple(G4double energy)
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoManager::PrintScan()
 {
+  if (! fFactoryOn || fScanH2Id < 0) return;
+
+  // in sequential mode the master scored the events itself
+  ReduceScan();
+
   G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
-  // Fill 1st ntuple ( id = 0)
-  analysisManager->FillNtupleDColumn(0, 0, energy);
-  analysisManager->AddNtupleRow(0);
+  tools::histo::h2d* h2 = analysisManager->GetH2(fScanH2Id, false);
+  tools::histo::h1d* h1 = analysisManager->GetH1(fScanEventsId, false);
+  if (! h2 || ! h1) return;
 
+  G4cout << "\n Detection efficiency per scan point, Edep in ["
+         << G4BestUnit(fEmin,"Energy") << ", " << G4BestUnit(fEmax,"Energy")
+         << "[ (position in mm):" << G4endl;
+  G4int nofPoints = fScanGrid->GetNofPoints();
+  for (G4int point = 0; point < nofPoints; ++point) {
+    G4int nofEvents = h1->bin_entries(point);
+    G4double sw = 0., sw2 = 0.;
+    for (G4int i = 0; i < fNbins; ++i) {
+      sw  += h2->bin_height(point, i);
+      sw2 += h2->bin_error(point, i)*h2->bin_error(point, i);
+    }
+    G4ThreeVector position = fScanGrid->GetPosition(point);
+    G4cout << std::setw(6) << point << "  ("
+           << position.x()/mm << ", " << position.y()/mm << ", "
+           << position.z()/mm << ")  " << nofEvents << " events";
+    if (nofEvents > 0) {
+      G4cout << "  efficiency " << sw/nofEvents
+             << " +- " << std::sqrt(sw2)/nofEvents;
+    }
+    G4cout << G4endl;
+  }
 }
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void HistoManager::FlushNtuple()
+{
+  if (! fFactoryOn || fOutputFormat != kRoot) {
+    fNtupleESpec.clear();
+    fNtupleWeight.clear();
+    return;
+  }
+
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  // Fill 1st ntuple ( id = 0), row by row: there is no block fill
+  for (std::size_t i = 0; i < fNtupleESpec.size(); ++i) {
+    analysisManager->FillNtupleDColumn(0, 0, fNtupleESpec[i]);
+    analysisManager->FillNtupleDColumn(0, 1, fNtupleWeight[i]);
+    analysisManager->AddNtupleRow(0);
+  }
+  fNtupleESpec.clear();
+  fNtupleWeight.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
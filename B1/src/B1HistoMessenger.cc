@@ -0,0 +1,254 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1HistoMessenger.cc
+/// \brief Implementation of the HistoMessenger class
+
+#include "B1HistoMessenger.hh"
+#include "B1HistoManager.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4Tokenizer.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+HistoMessenger::HistoMessenger(HistoManager* histo)
+ : G4UImessenger(),
+   fHistoManager(histo),
+   fB1Dir(0), fOutputDir(0),
+   fFileNameCmd(0), fFormatCmd(0), fSummaryCmd(0),
+   fResolutionDir(0), fFoldModeCmd(0), fFanoCmd(0),
+   fPairEnergyCmd(0), fNoiseCmd(0),
+   fHistoDir(0), fSpectrumCmd(0), fSparseCmd(0), fClearCmd(0)
+{
+  fB1Dir = new G4UIdirectory("/B1/");
+  fB1Dir->SetGuidance("UI commands of example B1");
+
+  fOutputDir = new G4UIdirectory("/B1/output/");
+  fOutputDir->SetGuidance("Output file control");
+
+  fFileNameCmd = new G4UIcmdWithAString("/B1/output/fileName",this);
+  fFileNameCmd->SetGuidance("Set the output file name, without extension.");
+  fFileNameCmd->SetParameterName("name",false);
+  fFileNameCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fFormatCmd = new G4UIcmdWithAString("/B1/output/format",this);
+  fFormatCmd->SetGuidance("Select the output of the per-event Edep.");
+  fFormatCmd->SetGuidance("  root   : ntuple in the ROOT file, merged on the master");
+  fFormatCmd->SetGuidance("  binary : one raw float32 file (keV) per thread,");
+  fFormatCmd->SetGuidance("           with a .json manifest, no merging");
+  fFormatCmd->SetGuidance("  none   : no per-event output");
+  fFormatCmd->SetGuidance("Histograms are written to the ROOT file in all cases.");
+  fFormatCmd->SetParameterName("format",false);
+  fFormatCmd->SetCandidates("root binary none");
+  fFormatCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fSummaryCmd = new G4UIcmdWithAString("/B1/output/summaryFile",this);
+  fSummaryCmd->SetGuidance("Write the run totals and the spectra, exactly, to");
+  fSummaryCmd->SetGuidance("this text file at end of run (used to merge shards).");
+  fSummaryCmd->SetGuidance("An empty name switches the summary off.");
+  fSummaryCmd->SetParameterName("name",true);
+  fSummaryCmd->SetDefaultValue("");
+  fSummaryCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fResolutionDir = new G4UIdirectory("/B1/resolution/");
+  fResolutionDir->SetGuidance("Ge energy resolution folding");
+
+  fFoldModeCmd = new G4UIcmdWithAString("/B1/resolution/mode",this);
+  fFoldModeCmd->SetGuidance("Fill ESpecFolded with the resolution applied.");
+  fFoldModeCmd->SetGuidance("  off   : no folded spectrum (default)");
+  fFoldModeCmd->SetGuidance("  event : fold each event at end of event");
+  fFoldModeCmd->SetParameterName("mode",false);
+  fFoldModeCmd->SetCandidates("off event");
+  fFoldModeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fFanoCmd = new G4UIcmdWithADouble("/B1/resolution/fano",this);
+  fFanoCmd->SetGuidance("Set the Fano factor.");
+  fFanoCmd->SetParameterName("fano",false);
+  fFanoCmd->SetRange("fano>=0.");
+  fFanoCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fPairEnergyCmd = new G4UIcmdWithADoubleAndUnit("/B1/resolution/pairEnergy",this);
+  fPairEnergyCmd->SetGuidance("Set the mean energy per electron-hole pair.");
+  fPairEnergyCmd->SetParameterName("w",false);
+  fPairEnergyCmd->SetRange("w>0.");
+  fPairEnergyCmd->SetUnitCategory("Energy");
+  fPairEnergyCmd->SetDefaultUnit("eV");
+  fPairEnergyCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fNoiseCmd = new G4UIcmdWithADoubleAndUnit("/B1/resolution/noise",this);
+  fNoiseCmd->SetGuidance("Set the FWHM of the electronic noise.");
+  fNoiseCmd->SetParameterName("fwhm",false);
+  fNoiseCmd->SetRange("fwhm>=0.");
+  fNoiseCmd->SetUnitCategory("Energy");
+  fNoiseCmd->SetDefaultUnit("eV");
+  fNoiseCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fHistoDir = new G4UIdirectory("/B1/histo/");
+  fHistoDir->SetGuidance("Spectra of the triggered events, besides ESpec");
+
+  fSpectrumCmd = new G4UIcommand("/B1/histo/addSpectrum",this);
+  fSpectrumCmd->SetGuidance("Add an H1 spectrum: name nbins emin emax unit scheme,");
+  fSpectrumCmd->SetGuidance("with linear (lin) or logarithmic (log) binning.");
+  G4UIparameter* namePrm = new G4UIparameter("name",'s',false);
+  fSpectrumCmd->SetParameter(namePrm);
+  G4UIparameter* nbinsPrm = new G4UIparameter("nbins",'i',false);
+  nbinsPrm->SetParameterRange("nbins>0");
+  fSpectrumCmd->SetParameter(nbinsPrm);
+  G4UIparameter* eminPrm = new G4UIparameter("emin",'d',false);
+  fSpectrumCmd->SetParameter(eminPrm);
+  G4UIparameter* emaxPrm = new G4UIparameter("emax",'d',false);
+  fSpectrumCmd->SetParameter(emaxPrm);
+  G4UIparameter* unitPrm = new G4UIparameter("unit",'s',true);
+  unitPrm->SetDefaultUnit("keV");
+  fSpectrumCmd->SetParameter(unitPrm);
+  G4UIparameter* schemePrm = new G4UIparameter("scheme",'s',true);
+  schemePrm->SetParameterCandidates("lin log");
+  schemePrm->SetDefaultValue("lin");
+  fSpectrumCmd->SetParameter(schemePrm);
+  fSpectrumCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fSparseCmd = new G4UIcommand("/B1/histo/addSparse",this);
+  fSparseCmd->SetGuidance("Add a sparse spectrum: name binWidth emin emax unit.");
+  fSparseCmd->SetGuidance("Only the filled bins are stored; the master writes them");
+  fSparseCmd->SetGuidance("to <fileName>_<name>.txt at end of run.");
+  G4UIparameter* sparseNamePrm = new G4UIparameter("name",'s',false);
+  fSparseCmd->SetParameter(sparseNamePrm);
+  G4UIparameter* widthPrm = new G4UIparameter("binWidth",'d',false);
+  widthPrm->SetParameterRange("binWidth>0.");
+  fSparseCmd->SetParameter(widthPrm);
+  G4UIparameter* sparseEminPrm = new G4UIparameter("emin",'d',false);
+  fSparseCmd->SetParameter(sparseEminPrm);
+  G4UIparameter* sparseEmaxPrm = new G4UIparameter("emax",'d',false);
+  fSparseCmd->SetParameter(sparseEmaxPrm);
+  G4UIparameter* sparseUnitPrm = new G4UIparameter("unit",'s',true);
+  sparseUnitPrm->SetDefaultUnit("keV");
+  fSparseCmd->SetParameter(sparseUnitPrm);
+  fSparseCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fClearCmd = new G4UIcmdWithoutParameter("/B1/histo/clear",this);
+  fClearCmd->SetGuidance("Remove the spectra added with /B1/histo/.");
+  fClearCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+HistoMessenger::~HistoMessenger()
+{
+  delete fClearCmd;
+  delete fSparseCmd;
+  delete fSpectrumCmd;
+  delete fHistoDir;
+  delete fNoiseCmd;
+  delete fPairEnergyCmd;
+  delete fFanoCmd;
+  delete fFoldModeCmd;
+  delete fResolutionDir;
+  delete fSummaryCmd;
+  delete fFormatCmd;
+  delete fFileNameCmd;
+  delete fOutputDir;
+  delete fB1Dir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fFileNameCmd) {
+    fHistoManager->SetFileName(newValue);
+  }
+
+  if (command == fSummaryCmd) {
+    fHistoManager->SetSummaryFileName(newValue);
+  }
+
+  if (command == fFormatCmd) {
+    if (newValue == "binary")    fHistoManager->SetOutputFormat(HistoManager::kBinary);
+    else if (newValue == "none") fHistoManager->SetOutputFormat(HistoManager::kNone);
+    else                         fHistoManager->SetOutputFormat(HistoManager::kRoot);
+  }
+
+  if (command == fFoldModeCmd) {
+    if (newValue == "event") fHistoManager->SetFoldingMode(HistoManager::kFoldEvent);
+    else                     fHistoManager->SetFoldingMode(HistoManager::kFoldOff);
+  }
+
+  if (command == fFanoCmd) {
+    fHistoManager->GetResolutionFolder()
+      .SetFanoFactor(fFanoCmd->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fPairEnergyCmd) {
+    fHistoManager->GetResolutionFolder()
+      .SetPairEnergy(fPairEnergyCmd->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fNoiseCmd) {
+    fHistoManager->GetResolutionFolder()
+      .SetNoiseFwhm(fNoiseCmd->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fSpectrumCmd) {
+    G4Tokenizer next(newValue);
+    G4String name = next();
+    G4int nbins = G4UIcommand::ConvertToInt(next());
+    G4double emin = G4UIcommand::ConvertToDouble(next());
+    G4double emax = G4UIcommand::ConvertToDouble(next());
+    G4double unit = G4UIcommand::ValueOf(next());
+    G4bool logBins = (next() == "log");
+    fHistoManager->AddSpectrum(name, nbins, emin*unit, emax*unit, logBins);
+  }
+
+  if (command == fSparseCmd) {
+    G4Tokenizer next(newValue);
+    G4String name = next();
+    G4double binWidth = G4UIcommand::ConvertToDouble(next());
+    G4double emin = G4UIcommand::ConvertToDouble(next());
+    G4double emax = G4UIcommand::ConvertToDouble(next());
+    G4double unit = G4UIcommand::ValueOf(next());
+    fHistoManager->AddSparseSpectrum(name, binWidth*unit, emin*unit, emax*unit);
+  }
+
+  if (command == fClearCmd) {
+    fHistoManager->ClearSpectra();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String HistoMessenger::GetCurrentValue(G4UIcommand* command)
+{
+  if (command == fFileNameCmd) return fHistoManager->GetFileName();
+  return "";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
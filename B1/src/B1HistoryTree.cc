@@ -0,0 +1,214 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1HistoryTree.cc
+/// \brief Implementation of the B1HistoryTree class
+
+#include "B1HistoryTree.hh"
+#include "B1ImportanceMap.hh"
+
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1HistoryTree::B1HistoryTree(const B1ImportanceMap* map)
+: fMap(map)
+{
+  Reset();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1HistoryTree::~B1HistoryTree()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistoryTree::Reset()
+{
+  fNodes.clear();
+  fBranchEdep.assign(1, 0.);
+  // the node lists are kept from event to event, and cleared when used
+  if (fBranchNodes.empty()) fBranchNodes.resize(1);
+  fBranchNodes[0].clear();
+  fAlternatives.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int B1HistoryTree::NewNode(G4int branch, G4int nofBranches,
+                             G4double survival)
+{
+  Node node;
+  node.fParent = branch;
+  node.fFirstBranch = fBranchEdep.size();
+  node.fNofBranches = nofBranches;
+  node.fSurvival = survival;
+  fBranchNodes[branch].push_back(fNodes.size());
+  fNodes.push_back(node);
+
+  std::size_t nofBranchesTotal = fBranchEdep.size() + nofBranches;
+  fBranchEdep.resize(nofBranchesTotal, 0.);
+  if (fBranchNodes.size() < nofBranchesTotal) {
+    fBranchNodes.resize(nofBranchesTotal);
+  }
+  for (std::size_t b = node.fFirstBranch; b < nofBranchesTotal; ++b) {
+    fBranchNodes[b].clear();
+  }
+  return node.fFirstBranch;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int B1HistoryTree::Split(G4int branch, G4int nofCopies)
+{
+  return NewNode(branch, nofCopies, 1.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int B1HistoryTree::Survive(G4int branch, G4double probability)
+{
+  return NewNode(branch, 1, probability);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistoryTree::AddEdep(G4int branch, G4double edep)
+{
+  if (branch < 0 || branch >= G4int(fBranchEdep.size())) branch = 0;
+  fBranchEdep[branch] += edep;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistoryTree::Resolve()
+{
+  fAlternatives.clear();
+  BranchMixture(0, fAlternatives);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistoryTree::BranchMixture(G4int branch, Mixture& mixture) const
+{
+  mixture.assign(1, std::make_pair(fBranchEdep[branch], 1.));
+
+  const std::vector<G4int>& nodes = fBranchNodes[branch];
+  Mixture nodeMixture;
+  std::size_t maxSize = fMap->GetMaxAlternatives();
+  for (std::size_t n = 0; n < nodes.size(); ++n) {
+    NodeMixture(fNodes[nodes[n]], nodeMixture);
+    // keeps the branch mixtures, hence the alternatives, within the limit
+    if (mixture.size()*nodeMixture.size() > maxSize) Sample(nodeMixture);
+    Convolve(mixture, nodeMixture);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistoryTree::NodeMixture(const Node& node, Mixture& mixture) const
+{
+  mixture.clear();
+  Mixture branchMixture;
+  G4double scale = 1./(node.fNofBranches*node.fSurvival);
+  for (G4int b = 0; b < node.fNofBranches; ++b) {
+    BranchMixture(node.fFirstBranch + b, branchMixture);
+    for (std::size_t i = 0; i < branchMixture.size(); ++i) {
+      mixture.push_back(
+        std::make_pair(branchMixture[i].first, branchMixture[i].second*scale));
+    }
+  }
+  // the roulette: the history without the track makes up the weight
+  if (node.fSurvival < 1.) {
+    mixture.push_back(std::make_pair(0., 1. - 1./node.fSurvival));
+  }
+  Compact(mixture);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistoryTree::Convolve(Mixture& mixture, const Mixture& other)
+{
+  // Edep 0 of weight 1, the most frequent case, changes nothing
+  if (other.size() == 1 && other[0].first == 0. && other[0].second == 1.) {
+    return;
+  }
+
+  Mixture sum;
+  sum.reserve(mixture.size()*other.size());
+  for (std::size_t i = 0; i < mixture.size(); ++i) {
+    for (std::size_t j = 0; j < other.size(); ++j) {
+      sum.push_back(std::make_pair(mixture[i].first + other[j].first,
+                                   mixture[i].second*other[j].second));
+    }
+  }
+  Compact(sum);
+  mixture.swap(sum);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistoryTree::Compact(Mixture& mixture)
+{
+  if (mixture.size() < 2) return;
+
+  std::sort(mixture.begin(), mixture.end());
+  std::size_t last = 0;
+  for (std::size_t i = 1; i < mixture.size(); ++i) {
+    if (mixture[i].first == mixture[last].first) {
+      mixture[last].second += mixture[i].second;
+    }
+    else {
+      mixture[++last] = mixture[i];
+    }
+  }
+  mixture.resize(last + 1);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistoryTree::Sample(Mixture& mixture)
+{
+  if (mixture.size() < 2) return;
+
+  G4double sum = 0.;
+  for (std::size_t i = 0; i < mixture.size(); ++i) {
+    sum += std::fabs(mixture[i].second);
+  }
+  G4double r = sum*G4UniformRand();
+  std::size_t i = 0;
+  for (; i < mixture.size() - 1; ++i) {
+    r -= std::fabs(mixture[i].second);
+    if (r < 0.) break;
+  }
+  G4double weight = ( mixture[i].second < 0. ) ? -sum : sum;
+  mixture.assign(1, std::make_pair(mixture[i].first, weight));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
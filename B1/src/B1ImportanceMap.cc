@@ -0,0 +1,94 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1ImportanceMap.cc
+/// \brief Implementation of the B1ImportanceMap class
+
+#include "B1ImportanceMap.hh"
+#include "B1ImportanceMessenger.hh"
+
+#include "G4VPhysicalVolume.hh"
+#include "G4ios.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ImportanceMap::B1ImportanceMap()
+: fMessenger(0),
+  fEnabled(false),
+  fMaxSplit(4),
+  fMaxAlternatives(64)
+{
+  fImportance["World"]    = 0.25;
+  fImportance["Envelope"] = 1.;
+  fImportance["Shape3"]   = 1.;
+  fImportance["Shape6"]   = 1.;
+  fImportance["Shape2"]   = 2.;
+  fImportance["Shape1_2"] = 4.;
+  fImportance["Shape1_1"] = 4.;
+
+  fMessenger = new B1ImportanceMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ImportanceMap::~B1ImportanceMap()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ImportanceMap::SetImportance(const G4String& volume,
+                                    G4double importance)
+{
+  if (importance <= 0.) return;
+  fImportance[volume] = importance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1ImportanceMap::GetImportance(const G4VPhysicalVolume* volume) const
+{
+  if (! volume) return 1.;
+  std::map<G4String, G4double>::const_iterator it
+    = fImportance.find(volume->GetName());
+  return ( it != fImportance.end() ) ? it->second : 1.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ImportanceMap::Print() const
+{
+  G4cout << "\n Importance sampling "
+         << ( fEnabled ? "on" : "off" ) << ", at most " << fMaxSplit
+         << " copies per split, at most " << fMaxAlternatives
+         << " alternatives per event:" << G4endl;
+  std::map<G4String, G4double>::const_iterator it;
+  for (it = fImportance.begin(); it != fImportance.end(); ++it) {
+    G4cout << "   " << it->first << " : " << it->second << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,134 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1ImportanceMessenger.cc
+/// \brief Implementation of the B1ImportanceMessenger class
+
+#include "B1ImportanceMessenger.hh"
+#include "B1ImportanceMap.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4Tokenizer.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ImportanceMessenger::B1ImportanceMessenger(B1ImportanceMap* map)
+ : G4UImessenger(),
+   fMap(map),
+   fImportanceDir(0),
+   fEnableCmd(0), fVolumeCmd(0), fMaxSplitCmd(0), fMaxAlternativesCmd(0),
+   fPrintCmd(0)
+{
+  fImportanceDir = new G4UIdirectory("/B1/importance/");
+  fImportanceDir->SetGuidance("Importance splitting and Russian roulette");
+
+  fEnableCmd = new G4UIcmdWithABool("/B1/importance/enable",this);
+  fEnableCmd->SetGuidance("Split the tracks moving towards the Ge crystal and");
+  fEnableCmd->SetGuidance("roulette those moving away, by volume importance.");
+  fEnableCmd->SetParameterName("flag",true);
+  fEnableCmd->SetDefaultValue(true);
+  fEnableCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fEnableCmd->SetToBeBroadcasted(false);
+
+  fVolumeCmd = new G4UIcommand("/B1/importance/volume",this);
+  fVolumeCmd->SetGuidance("Set the importance of a physical volume, by name.");
+  fVolumeCmd->SetGuidance("Volumes not set have importance 1.");
+  G4UIparameter* namePrm = new G4UIparameter("name",'s',false);
+  fVolumeCmd->SetParameter(namePrm);
+  G4UIparameter* importancePrm = new G4UIparameter("importance",'d',false);
+  importancePrm->SetParameterRange("importance>0.");
+  fVolumeCmd->SetParameter(importancePrm);
+  fVolumeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fVolumeCmd->SetToBeBroadcasted(false);
+
+  fMaxSplitCmd = new G4UIcmdWithAnInteger("/B1/importance/maxSplit",this);
+  fMaxSplitCmd->SetGuidance("Maximum number of copies of a track per split.");
+  fMaxSplitCmd->SetParameterName("n",false);
+  fMaxSplitCmd->SetRange("n>=1");
+  fMaxSplitCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fMaxSplitCmd->SetToBeBroadcasted(false);
+
+  fMaxAlternativesCmd
+    = new G4UIcmdWithAnInteger("/B1/importance/maxAlternatives",this);
+  fMaxAlternativesCmd->SetGuidance("Maximum number of weighted Edep values scored");
+  fMaxAlternativesCmd->SetGuidance("per event; beyond it a split is resolved by");
+  fMaxAlternativesCmd->SetGuidance("keeping one copy drawn at random (unbiased).");
+  fMaxAlternativesCmd->SetParameterName("n",false);
+  fMaxAlternativesCmd->SetRange("n>=1");
+  fMaxAlternativesCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fMaxAlternativesCmd->SetToBeBroadcasted(false);
+
+  fPrintCmd = new G4UIcmdWithoutParameter("/B1/importance/print",this);
+  fPrintCmd->SetGuidance("Print the importance of the volumes.");
+  fPrintCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fPrintCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ImportanceMessenger::~B1ImportanceMessenger()
+{
+  delete fPrintCmd;
+  delete fMaxAlternativesCmd;
+  delete fMaxSplitCmd;
+  delete fVolumeCmd;
+  delete fEnableCmd;
+  delete fImportanceDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ImportanceMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fEnableCmd) {
+    fMap->SetEnabled(fEnableCmd->GetNewBoolValue(newValue));
+  }
+
+  if (command == fVolumeCmd) {
+    G4Tokenizer next(newValue);
+    G4String name = next();
+    G4double importance = G4UIcommand::ConvertToDouble(next());
+    fMap->SetImportance(name, importance);
+  }
+
+  if (command == fMaxSplitCmd) {
+    fMap->SetMaxSplit(fMaxSplitCmd->GetNewIntValue(newValue));
+  }
+
+  if (command == fMaxAlternativesCmd) {
+    fMap->SetMaxAlternatives(fMaxAlternativesCmd->GetNewIntValue(newValue));
+  }
+
+  if (command == fPrintCmd) {
+    fMap->Print();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
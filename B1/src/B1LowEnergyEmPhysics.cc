@@ -0,0 +1,125 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1LowEnergyEmPhysics.cc
+/// \brief Implementation of the B1LowEnergyEmPhysics class
+
+#include "B1LowEnergyEmPhysics.hh"
+
+#include "G4Gamma.hh"
+#include "G4Electron.hh"
+#include "G4Positron.hh"
+#include "G4Proton.hh"
+#include "G4Geantino.hh"
+#include "G4ChargedGeantino.hh"
+
+#include "G4PhysicsListHelper.hh"
+#include "G4PhotoElectricEffect.hh"
+#include "G4LivermorePhotoElectricModel.hh"
+#include "G4ComptonScattering.hh"
+#include "G4LivermoreComptonModel.hh"
+#include "G4RayleighScattering.hh"
+#include "G4eMultipleScattering.hh"
+#include "G4eIonisation.hh"
+#include "G4LivermoreIonisationModel.hh"
+#include "G4eBremsstrahlung.hh"
+
+#include "G4EmParameters.hh"
+#include "G4LossTableManager.hh"
+#include "G4UAtomicDeexcitation.hh"
+#include "G4SystemOfUnits.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1LowEnergyEmPhysics::B1LowEnergyEmPhysics(G4int verbose)
+ : G4VPhysicsConstructor("B1LowEnergyEm")
+{
+  SetVerboseLevel(verbose);
+
+  // the parameters are locked after initialisation
+  G4EmParameters* param = G4EmParameters::Instance();
+  param->SetDefaults();
+  param->SetVerbose(verbose);
+  param->SetMinEnergy(100*eV);
+  param->SetMaxEnergy(1*MeV);
+  param->SetLowestElectronEnergy(100*eV);
+  param->SetFluo(true);
+  param->SetAuger(false);
+  param->SetPixe(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1LowEnergyEmPhysics::~B1LowEnergyEmPhysics()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1LowEnergyEmPhysics::ConstructParticle()
+{
+  G4Gamma::GammaDefinition();
+  G4Electron::ElectronDefinition();
+  G4Positron::PositronDefinition();
+  G4Proton::ProtonDefinition();
+  G4Geantino::GeantinoDefinition();
+  G4ChargedGeantino::ChargedGeantinoDefinition();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1LowEnergyEmPhysics::ConstructProcess()
+{
+  G4PhysicsListHelper* ph = G4PhysicsListHelper::GetPhysicsListHelper();
+
+  // gamma
+  G4ParticleDefinition* gamma = G4Gamma::Gamma();
+
+  G4PhotoElectricEffect* pe = new G4PhotoElectricEffect();
+  pe->SetEmModel(new G4LivermorePhotoElectricModel());
+  ph->RegisterProcess(pe, gamma);
+
+  G4ComptonScattering* cs = new G4ComptonScattering();
+  cs->SetEmModel(new G4LivermoreComptonModel());
+  ph->RegisterProcess(cs, gamma);
+
+  ph->RegisterProcess(new G4RayleighScattering(), gamma);
+
+  // e-
+  G4ParticleDefinition* electron = G4Electron::Electron();
+
+  ph->RegisterProcess(new G4eMultipleScattering(), electron);
+
+  G4eIonisation* eIoni = new G4eIonisation();
+  eIoni->SetEmModel(new G4LivermoreIonisationModel());
+  ph->RegisterProcess(eIoni, electron);
+
+  ph->RegisterProcess(new G4eBremsstrahlung(), electron);
+
+  // fluorescence of the Ge and Fe K shells
+  G4LossTableManager::Instance()->SetAtomDeexcitation(
+    new G4UAtomicDeexcitation());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
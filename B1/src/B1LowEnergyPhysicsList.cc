@@ -0,0 +1,39 @@
+
+#include "B1LowEnergyPhysicsList.hh" //包含此源文件对应的头文件
+
+#include "B1LowEnergyEmPhysics.hh"
+#include "B1PhysicsTableCache.hh"
+
+#include "G4StepLimiterPhysics.hh"
+
+#include "G4ProductionCutsTable.hh"
+#include "G4SystemOfUnits.hh"
+
+
+LowEnergyPhysicsList::LowEnergyPhysicsList() 
+: G4VModularPhysicsList(), fTableCache(0){ 
+//定义构造函数
+  SetVerboseLevel(1);
+
+  RegisterPhysics(new B1LowEnergyEmPhysics());//只注册低能电磁物理过程
+
+  RegisterPhysics(new G4StepLimiterPhysics());//使/B1/det/regionStepMax设置的步长限制生效
+
+  SetDefaultCutValue(1*cm);//世界与空气包络使用粗截断，探测器各区域的截断见B1DetectorConstruction
+
+  fTableCache = new B1PhysicsTableCache(this);//物理表缓存，目录由环境变量B1_PHYSICS_CACHE指定
+}
+
+
+LowEnergyPhysicsList::~LowEnergyPhysicsList()
+{ 
+  delete fTableCache;
+}
+
+void LowEnergyPhysicsList::SetCuts()
+{
+  //产生阈值的下限降到250 eV，上限与物理表一致
+  G4ProductionCutsTable::GetProductionCutsTable()->SetEnergyRange(250*eV, 1*MeV);
+
+  G4VUserPhysicsList::SetCuts();
+}  
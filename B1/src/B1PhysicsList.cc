@@ -7,13 +7,23 @@
 #include "G4EmExtraPhysics.hh"
 #include "G4GenericBiasingPhysics.hh"
 #include "G4IonPhysics.hh"
+#include "G4StepLimiterPhysics.hh"
+#include "G4SystemOfUnits.hh"
 #include "G4RadioactiveDecay.hh"
+#include "G4GenericIon.hh"
+#include "G4ProcessManager.hh"
+#include "G4DecayProcessType.hh"
+
+#include "B1BiasedDecay.hh"
+#include "B1PhysicsListMessenger.hh"
+#include "B1PhysicsTableCache.hh"
 
 
 //包含将要指定的物理过程的头文件
 
 PhysicsList::PhysicsList() 
-: G4VModularPhysicsList(){ 
+: G4VModularPhysicsList(),
+  fMessenger(0), fTableCache(0), fDecayBiasing(false), fConeProbability(0.9){ 
 //定义构造函数
   SetVerboseLevel(1);//指定输出信息的复杂度，越高越复杂，一般设置为1即可
 
@@ -24,12 +34,53 @@ PhysicsList::PhysicsList()
   RegisterPhysics(new G4RadioactiveDecayPhysics());//指定放射性核素衰变物理过程
 
   RegisterPhysics(new G4IonPhysics());
+
+  RegisterPhysics(new G4StepLimiterPhysics());//使/B1/det/regionStepMax设置的步长限制生效
+
+  SetDefaultCutValue(1*cm);//世界与空气包络使用粗截断，探测器各区域的截断见B1DetectorConstruction
+
+  fMessenger = new PhysicsListMessenger(this);///B1/bias/命令
+
+  fTableCache = new B1PhysicsTableCache(this);//物理表缓存，目录由环境变量B1_PHYSICS_CACHE指定
 }
 
 
 PhysicsList::~PhysicsList()
-//定义析构函数，一般为空
+//定义析构函数
 { 
+  delete fTableCache;
+  delete fMessenger;
+}
+
+void PhysicsList::ConstructProcess()
+//每个线程各自调用一次
+{
+  G4VModularPhysicsList::ConstructProcess();
+
+  if (fDecayBiasing) WrapRadioactiveDecay();
+}
+
+void PhysicsList::WrapRadioactiveDecay()
+//按子类型查找放射性衰变过程（不依赖过程名），保持原有的排序参数
+{
+  G4ProcessManager* pManager = G4GenericIon::GenericIon()->GetProcessManager();
+  G4ProcessVector* processList = pManager->GetProcessList();
+
+  for (G4int i = 0; i < G4int(processList->size()); ++i) {
+    G4VProcess* process = (*processList)[i];
+    if (process->GetProcessType() != fDecay ||
+        process->GetProcessSubType() != DECAY_Radioactive) continue;
+
+    G4int ordAtRest = pManager->GetProcessOrdering(process, idxAtRest);
+    G4int ordPostStep = pManager->GetProcessOrdering(process, idxPostStep);
+    pManager->RemoveProcess(process);
+    pManager->AddProcess(new B1BiasedDecay(process, fConeProbability),
+                         ordAtRest, -1, ordPostStep);
+    return;
+  }
+
+  G4Exception("PhysicsList::WrapRadioactiveDecay()",
+   "B1Bias0002",JustWarning,"No radioactive decay process to bias.");
 }
 
 void PhysicsList::SetCuts()
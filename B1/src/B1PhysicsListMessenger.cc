@@ -0,0 +1,87 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1PhysicsListMessenger.cc
+/// \brief Implementation of the PhysicsListMessenger class
+
+#include "B1PhysicsListMessenger.hh"
+#include "B1PhysicsList.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADouble.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhysicsListMessenger::PhysicsListMessenger(PhysicsList* physicsList)
+ : G4UImessenger(),
+   fPhysicsList(physicsList),
+   fBiasDir(0),
+   fDecayConeCmd(0), fConeProbCmd(0)
+{
+  fBiasDir = new G4UIdirectory("/B1/bias/");
+  fBiasDir->SetGuidance("Variance reduction");
+
+  fDecayConeCmd = new G4UIcmdWithABool("/B1/bias/decayCone",this);
+  fDecayConeCmd->SetGuidance("Force the radioactive decay photons into the cone");
+  fDecayConeCmd->SetGuidance("subtended by the Ge crystal and the carbon window.");
+  fDecayConeCmd->SetGuidance("The events are weighted accordingly.");
+  fDecayConeCmd->SetParameterName("flag",true);
+  fDecayConeCmd->SetDefaultValue(true);
+  fDecayConeCmd->AvailableForStates(G4State_PreInit);
+  fDecayConeCmd->SetToBeBroadcasted(false);
+
+  fConeProbCmd = new G4UIcmdWithADouble("/B1/bias/coneProbability",this);
+  fConeProbCmd->SetGuidance("Probability to emit a decay photon into the cone.");
+  fConeProbCmd->SetGuidance("With 1, photons outside of the cone are dropped.");
+  fConeProbCmd->SetParameterName("prob",false);
+  fConeProbCmd->SetRange("prob>0. && prob<=1.");
+  fConeProbCmd->AvailableForStates(G4State_PreInit);
+  fConeProbCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhysicsListMessenger::~PhysicsListMessenger()
+{
+  delete fConeProbCmd;
+  delete fDecayConeCmd;
+  delete fBiasDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsListMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fDecayConeCmd) {
+    fPhysicsList->SetDecayBiasing(fDecayConeCmd->GetNewBoolValue(newValue));
+  }
+
+  if (command == fConeProbCmd) {
+    fPhysicsList->SetConeProbability(fConeProbCmd->GetNewDoubleValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
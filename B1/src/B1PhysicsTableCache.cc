@@ -0,0 +1,257 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1PhysicsTableCache.cc
+/// \brief Implementation of the B1PhysicsTableCache class
+
+#include "B1PhysicsTableCache.hh"
+#include "B1Hash.hh"
+
+#include "G4VModularPhysicsList.hh"
+#include "G4VPhysicsConstructor.hh"
+#include "G4StateManager.hh"
+#include "G4EmParameters.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4ProductionCuts.hh"
+#include "G4RegionStore.hh"
+#include "G4Region.hh"
+#include "G4Material.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Threading.hh"
+#include "G4Version.hh"
+
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PhysicsTableCache::B1PhysicsTableCache(G4VModularPhysicsList* physicsList)
+ : G4VStateDependent(),
+   fPhysicsList(physicsList),
+   fCacheDir("B1PhysicsTables"),
+   fTableKey(""),
+   fRetrievedKey(""),
+   fInitialised(false)
+{
+  const char* cacheDir = std::getenv("B1_PHYSICS_CACHE");
+  if (cacheDir) fCacheDir = cacheDir;
+  if (fCacheDir == "none") fCacheDir = "";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PhysicsTableCache::~B1PhysicsTableCache()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1PhysicsTableCache::Notify(G4ApplicationState requestedState)
+{
+  if (fCacheDir.empty() || ! G4Threading::IsMasterThread()) return true;
+
+  G4ApplicationState currentState
+    = G4StateManager::GetStateManager()->GetCurrentState();
+
+  // initialisation starts, by G4RunManager::Initialize() or before a
+  // run: the tables of a known key are retrieved if they are rebuilt
+  if (currentState == G4State_Idle && requestedState == G4State_Init) {
+    fInitialised = false;
+    fRetrievedKey = "";
+    G4String key = Key();
+    if (key == fTableKey) return true;   // no rebuild with new settings
+
+    G4String entry = fCacheDir + "/" + key;
+    std::ifstream complete(entry + "/complete");
+    if (complete) {
+      G4cout << "Physics tables retrieved from " << entry << G4endl;
+      fPhysicsList->SetPhysicsTableRetrieved(entry);
+      fRetrievedKey = key;
+    }
+    return true;
+  }
+
+  // initialisation done; the settings may change before the next one
+  if (currentState == G4State_Init && requestedState == G4State_Idle) {
+    if (! fRetrievedKey.empty()) fPhysicsList->ResetPhysicsTableRetrieved();
+    fInitialised = true;
+    return true;
+  }
+
+  // only the run initialisation, which builds the tables, closes the
+  // geometry right after Init -> Idle: the tables of a new key are
+  // stored, under the key of the settings they were built with
+  if (currentState == G4State_Idle && requestedState == G4State_GeomClosed
+      && fInitialised) {
+    G4String key = Key();
+    if (key != fTableKey && key != fRetrievedKey) Store(key);
+    fTableKey = key;
+  }
+  if (currentState == G4State_Idle) {
+    fInitialised = false;
+    fRetrievedKey = "";
+  }
+
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PhysicsTableCache::Store(const G4String& key)
+{
+  // the tables are written to a directory of this job, which is renamed
+  // to the entry once complete: an interrupted or failed store never
+  // leaves a partial entry behind
+  G4String entry = fCacheDir + "/" + key;
+  std::ostringstream os;
+  os << entry << ".tmp" << ::getpid();
+  G4String tmpDir = os.str();
+
+  ::mkdir(fCacheDir.c_str(), 0755);
+  RemoveDirectory(tmpDir);
+  if (::mkdir(tmpDir.c_str(), 0755) != 0) {
+    G4ExceptionDescription msg;
+    msg << "Cannot create " << tmpDir << ", physics tables not cached.";
+    G4Exception("B1PhysicsTableCache::Store()",
+     "B1Cache0001",JustWarning,msg);
+    return;
+  }
+
+  G4bool stored = fPhysicsList->StorePhysicsTable(tmpDir);
+  if (stored) {
+    std::ofstream complete(tmpDir + "/complete");
+    complete << key << "\n";
+    complete.close();
+    stored = ! complete.fail();
+  }
+  if (stored && ::rename(tmpDir.c_str(), entry.c_str()) != 0) {
+    // an entry left incomplete by an older job is moved aside and
+    // replaced; a complete one was stored by a concurrent job
+    std::ifstream complete(entry + "/complete");
+    G4String stale = tmpDir + ".stale";
+    stored = ! complete
+          && ::rename(entry.c_str(), stale.c_str()) == 0
+          && ::rename(tmpDir.c_str(), entry.c_str()) == 0;
+    RemoveDirectory(stale);
+  }
+  if (stored) {
+    G4cout << "Physics tables stored in " << entry << G4endl;
+  }
+  else {
+    RemoveDirectory(tmpDir);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PhysicsTableCache::RemoveDirectory(const G4String& dir)
+{
+  // the physics tables are plain files, with no subdirectories
+  DIR* stream = ::opendir(dir.c_str());
+  if (! stream) return;
+  while (struct dirent* file = ::readdir(stream)) {
+    G4String name = file->d_name;
+    if (name == "." || name == "..") continue;
+    std::remove((dir + "/" + name).c_str());
+  }
+  ::closedir(stream);
+  ::rmdir(dir.c_str());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String B1PhysicsTableCache::Key() const
+{
+  std::ostringstream os;
+  os << std::setprecision(17) << G4VERSION_NUMBER << "\n";
+
+  // registered constructors
+  for (G4int i = 0; fPhysicsList->GetPhysics(i); ++i) {
+    os << fPhysicsList->GetPhysics(i)->GetPhysicsName() << "\n";
+  }
+  G4EmParameters::Instance()->StreamInfo(os);
+
+  // production cuts
+  G4ProductionCutsTable* cutsTable
+    = G4ProductionCutsTable::GetProductionCutsTable();
+  os << fPhysicsList->GetDefaultCutValue() << " "
+     << cutsTable->GetLowEdgeEnergy() << " "
+     << cutsTable->GetHighEdgeEnergy() << "\n";
+  G4RegionStore* regionStore = G4RegionStore::GetInstance();
+  for (std::size_t i = 0; i < regionStore->size(); ++i) {
+    G4Region* region = (*regionStore)[i];
+    os << region->GetName();
+    G4ProductionCuts* cuts = region->GetProductionCuts();
+    if (cuts) {
+      const std::vector<G4double>& values = cuts->GetProductionCuts();
+      for (std::size_t j = 0; j < values.size(); ++j) os << " " << values[j];
+    }
+    os << "\n";
+  }
+
+  // material of each volume and its region; the material lists of the
+  // regions are only filled later, when the couples are updated
+  G4LogicalVolumeStore* volumeStore = G4LogicalVolumeStore::GetInstance();
+  for (std::size_t i = 0; i < volumeStore->size(); ++i) {
+    const G4LogicalVolume* volume = (*volumeStore)[i];
+    os << volume->GetName() << " "
+       << (volume->GetMaterial() ? volume->GetMaterial()->GetName() : G4String("-"))
+       << " "
+       << (volume->GetRegion() ? volume->GetRegion()->GetName() : G4String("-"))
+       << "\n";
+  }
+
+  // materials
+  const G4MaterialTable* materials = G4Material::GetMaterialTable();
+  for (std::size_t i = 0; i < materials->size(); ++i) {
+    const G4Material* material = (*materials)[i];
+    os << material->GetName() << " " << material->GetDensity();
+    const G4double* fractions = material->GetFractionVector();
+    for (std::size_t j = 0; j < material->GetNumberOfElements(); ++j) {
+      os << " " << material->GetElement(j)->GetName() << " " << fractions[j];
+    }
+    os << "\n";
+  }
+
+  // data sets
+  const char* dataSets[] = { "G4LEDATA", "G4LEVELGAMMADATA",
+    "G4RADIOACTIVEDATA", "G4ENSDFSTATEDATA", "G4PARTICLEXSDATA" };
+  for (std::size_t i = 0; i < sizeof(dataSets)/sizeof(dataSets[0]); ++i) {
+    const char* path = std::getenv(dataSets[i]);
+    os << dataSets[i] << "=" << (path ? path : "") << "\n";
+  }
+
+  return B1Hash::Fnv1a(os.str());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -28,11 +28,17 @@
 /// \brief Implementation of the B1PrimaryGeneratorAction class
 
 #include "B1PrimaryGeneratorAction.hh"
+#include "B1PrimaryGeneratorMessenger.hh"
+#include "B1Profiler.hh"
+#include "B1ScanGrid.hh"
+#include "B1ScanScheduler.hh"
+#include "B1EventInformation.hh"
 
 #include "G4LogicalVolumeStore.hh"
 #include "G4LogicalVolume.hh"
 #include "G4Box.hh"
 #include "G4RunManager.hh"
+#include "G4Threading.hh"
 #include "G4ParticleGun.hh"
 #include "G4ParticleTable.hh"
 #include "G4ParticleDefinition.hh"
@@ -40,13 +46,43 @@
 #include "Randomize.hh"
 #include "G4Geantino.hh"
 #include "G4IonTable.hh"
+#include "G4Gamma.hh"
+#include "G4Electron.hh"
+#include "G4Event.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PhysicalConstants.hh"
+
+namespace {
+
+// SplitMix64 finaliser: a full avalanche of the 64 input bits
+unsigned long long Mix64(unsigned long long x)
+{
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30))*0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27))*0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-B1PrimaryGeneratorAction::B1PrimaryGeneratorAction()
+B1PrimaryGeneratorAction::B1PrimaryGeneratorAction(B1Profiler* profiler,
+                                                   B1ScanGrid* grid)
 : G4VUserPrimaryGeneratorAction(),
   fParticleGun(0), 
-  fEnvelopeBox(0)
+  fEnvelopeBox(0),
+  fMessenger(0),
+  fProfiler(profiler),
+  fScanGrid(grid),
+  fSourceMode(kIon),
+  fRunSeed(0),
+  fFirstEvent(0),
+  fDefaultPosition(),
+  fScanning(false),
+  fBatchPoint(0),
+  fBatchLeft(0),
+  fBatchRun(-1)
 {
   G4int n_particle = 1;
   fParticleGun  = new G4ParticleGun(n_particle);
@@ -62,21 +98,168 @@ B1PrimaryGeneratorAction::B1PrimaryGeneratorAction()
 
   fParticleGun->SetParticleEnergy(0*eV);
   fParticleGun->SetParticlePosition(G4ThreeVector(0.*cm, 0.*cm, -0.2*cm));
+
+  BuildLineTable();
+
+  fMessenger = new B1PrimaryGeneratorMessenger(this);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1PrimaryGeneratorAction::~B1PrimaryGeneratorAction()
 {
+  delete fMessenger;
   delete fParticleGun;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void B1PrimaryGeneratorAction::SetSourceMode(SourceMode mode)
+{
+  // back to the ion: let GeneratePrimaries() create it again
+  if (mode == kIon && fSourceMode != kIon) {
+    fParticleGun->SetParticleDefinition(G4Geantino::Geantino());
+    fParticleGun->SetParticleEnergy(0*eV);
+  }
+  fSourceMode = mode;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PrimaryGeneratorAction::BuildLineTable()
+{
+  // Co-57 emissions per 100 decays (Fe-57 daughter), from DDEP/NNDC
+  // evaluations. L X-rays and L Auger electrons (< 1 keV) are omitted.
+  struct Line { G4bool gamma; G4double energy; G4double intensity; };
+  static const Line lines[] = {
+    // gamma rays
+    { true,   14.4129*keV,   9.16  },
+    { true,  122.0607*keV,  85.60  },
+    { true,  136.4736*keV,  10.68  },
+    { true,  692.41*keV,     0.149 },
+    // Fe K X-rays
+    { true,    6.3908*keV,  16.6   },   // K alpha2
+    { true,    6.4038*keV,  32.6   },   // K alpha1
+    { true,    7.058*keV,    6.6   },   // K beta
+    // conversion electrons
+    { false,   7.30*keV,    70.5   },   // K, 14.4 keV transition
+    { false,  13.57*keV,     7.4   },   // L, 14.4 keV transition
+    { false,  14.30*keV,     1.1   },   // M, 14.4 keV transition
+    { false, 115.18*keV,     1.8   },   // K, 122 keV transition
+    { false, 129.36*keV,     1.3   },   // K, 136 keV transition
+    // K Auger electrons
+    { false,   5.6*keV,    105.    }
+  };
+
+  std::vector<G4double> intensities;
+  for (std::size_t i = 0; i < sizeof(lines)/sizeof(lines[0]); ++i) {
+    fLineParticle.push_back(lines[i].gamma ? 
+      static_cast<G4ParticleDefinition*>(G4Gamma::Gamma()) :
+      static_cast<G4ParticleDefinition*>(G4Electron::Electron()));
+    fLineEnergy.push_back(lines[i].energy);
+    intensities.push_back(lines[i].intensity/100.);
+  }
+  fLineTable.Build(intensities);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PrimaryGeneratorAction::GenerateLine(G4Event* anEvent)
+{
+  std::size_t i = fLineTable.Sample(G4UniformRand());
+  fParticleGun->SetParticleDefinition(fLineParticle[i]);
+  fParticleGun->SetParticleEnergy(fLineEnergy[i]);
+
+  // isotropic emission, or in the cone of the scan around +z
+  G4double cosMin = -1.;
+  if (fScanning && fScanGrid->GetConeAngle() > 0.) {
+    cosMin = std::cos(fScanGrid->GetConeAngle());
+  }
+  G4double cosTheta = cosMin + (1. - cosMin)*G4UniformRand();
+  G4double sinTheta = std::sqrt((1. - cosTheta)*(1. + cosTheta));
+  G4double phi = twopi*G4UniformRand();
+  fParticleGun->SetParticleMomentumDirection(
+    G4ThreeVector(sinTheta*std::cos(phi), sinTheta*std::sin(phi), cosTheta));
+
+  fParticleGun->GeneratePrimaryVertex(anEvent);
+
+  // one emission stands for all the emissions of a decay, and only the
+  // fraction of them in the cone is emitted
+  anEvent->GetPrimaryVertex()->SetWeight(
+    fLineTable.GetTotalWeight()*0.5*(1. - cosMin));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PrimaryGeneratorAction::SeedEvent(G4long eventNumber)
+{
+  // Two seeds in [1, 2^31-1], as the run manager uses: MixMax maps
+  // distinct seed pairs to disjoint streams. This overrides the seeds
+  // the run manager drew from the master engine for this event.
+  unsigned long long h1 = Mix64(Mix64(fRunSeed) ^ (unsigned long long)eventNumber);
+  unsigned long long h2 = Mix64(h1);
+  G4long seeds[3] = { G4long(h1 % 2147483647ULL) + 1,
+                      G4long(h2 % 2147483647ULL) + 1,
+                      0 };
+  G4Random::setTheSeeds(seeds, -1);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PrimaryGeneratorAction::PlaceSource(G4Event* anEvent)
+{
+  if (fScanGrid && fScanGrid->IsActive()) {
+    if (! fScanning) fDefaultPosition = fParticleGun->GetParticlePosition();
+    fScanning = true;
+    G4int point = 0;
+    B1ScanScheduler* scheduler = fScanGrid->GetScheduler();
+    if (scheduler->IsActive()) {
+      // a new batch when the current one is used up or from a previous run
+      if (fBatchLeft == 0 || fBatchRun != scheduler->GetRunIndex()) {
+        if (fBatchRun != scheduler->GetRunIndex() && fRunSeed != 0
+            && G4Threading::G4GetThreadId() <= 0) {
+          G4ExceptionDescription msg;
+          msg << "The adaptive scan hands the points out to the threads in"
+              << " the order they ask;
+the events are not reproducible"
+              << " from /B1/random/eventSeeds and their event number.";
+          G4Exception("B1PrimaryGeneratorAction::PlaceSource()",
+           "MyCode0004",JustWarning,msg);
+        }
+        fBatchRun = scheduler->GetRunIndex();
+        fBatchPoint = scheduler->NextBatch();
+        fBatchLeft = scheduler->GetBatchSize();
+      }
+      fBatchLeft--;
+      point = fBatchPoint;
+    }
+    else {
+      point = fScanGrid->SelectPoint(fFirstEvent + anEvent->GetEventID());
+    }
+    fParticleGun->SetParticlePosition(fScanGrid->GetPosition(point));
+    anEvent->SetUserInformation(new B1EventInformation(point));
+  }
+  else if (fScanning) {
+    fParticleGun->SetParticlePosition(fDefaultPosition);
+    fScanning = false;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 void B1PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
 {
   //this function is called at the begining of ecah event
   //
+  if (fProfiler) fProfiler->StartEvent();
+
+  if (fRunSeed != 0) SeedEvent(fFirstEvent + anEvent->GetEventID());
+  PlaceSource(anEvent);
+
+  if (fSourceMode == kLines) {
+    GenerateLine(anEvent);
+    return;
+  }
 
   // In order to avoid dependence of PrimaryGeneratorAction
   // on DetectorConstruction class we get Envelope volume
@@ -121,6 +304,13 @@ void B1PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
     G4double excitEnergy = 0.*keV;
 
     G4ParticleDefinition* ion = G4IonTable::GetIonTable()->GetIon(Z, A, excitEnergy);
+    if ( ! ion ) {
+      G4ExceptionDescription msg;
+      msg << "Co-57 ion not available: the physics list has no GenericIon.\n";
+      msg << "The low-energy physics list must be used with /B1/gun/mode lines.";
+      G4Exception("B1PrimaryGeneratorAction::GeneratePrimaries()",
+       "MyCode0003",FatalException,msg);
+    }
 
     fParticleGun->SetParticleDefinition(ion);
     fParticleGun->SetParticleCharge(ionCharge);
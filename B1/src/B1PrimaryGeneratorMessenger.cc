@@ -0,0 +1,110 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1PrimaryGeneratorMessenger.cc
+/// \brief Implementation of the B1PrimaryGeneratorMessenger class
+
+#include "B1PrimaryGeneratorMessenger.hh"
+#include "B1PrimaryGeneratorAction.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PrimaryGeneratorMessenger::B1PrimaryGeneratorMessenger(
+                                            B1PrimaryGeneratorAction* action)
+ : G4UImessenger(),
+   fAction(action),
+   fGunDir(0),
+   fModeCmd(0),
+   fRandomDir(0),
+   fEventSeedsCmd(0),
+   fFirstEventCmd(0)
+{
+  fGunDir = new G4UIdirectory("/B1/gun/");
+  fGunDir->SetGuidance("Primary source control");
+
+  fModeCmd = new G4UIcmdWithAString("/B1/gun/mode",this);
+  fModeCmd->SetGuidance("Select the Co-57 source.");
+  fModeCmd->SetGuidance("  ion   : Co-57 ion at rest, decayed by G4RadioactiveDecay");
+  fModeCmd->SetGuidance("  lines : one emission per event, sampled from the");
+  fModeCmd->SetGuidance("          tabulated Co-57 line list");
+  fModeCmd->SetParameterName("mode",false);
+  fModeCmd->SetCandidates("ion lines");
+  fModeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fRandomDir = new G4UIdirectory("/B1/random/");
+  fRandomDir->SetGuidance("Per-event seeding");
+
+  fEventSeedsCmd = new G4UIcmdWithAnInteger("/B1/random/eventSeeds",this);
+  fEventSeedsCmd->SetGuidance("Reseed the engine at each event from (runSeed, event number)");
+  fEventSeedsCmd->SetGuidance("only, whatever the number of threads or processes.");
+  fEventSeedsCmd->SetGuidance("0 restores the seeding of the run manager.");
+  fEventSeedsCmd->SetParameterName("runSeed",false);
+  fEventSeedsCmd->SetRange("runSeed>=0");
+  fEventSeedsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fFirstEventCmd = new G4UIcmdWithAnInteger("/B1/random/firstEvent",this);
+  fFirstEventCmd->SetGuidance("Event number of the first event of the next run,");
+  fFirstEventCmd->SetGuidance("to recompute a range of events (event number = ID + first).");
+  fFirstEventCmd->SetGuidance("It then advances by the number of events of each run.");
+  fFirstEventCmd->SetParameterName("first",false);
+  fFirstEventCmd->SetRange("first>=0");
+  fFirstEventCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PrimaryGeneratorMessenger::~B1PrimaryGeneratorMessenger()
+{
+  delete fFirstEventCmd;
+  delete fEventSeedsCmd;
+  delete fRandomDir;
+  delete fModeCmd;
+  delete fGunDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PrimaryGeneratorMessenger::SetNewValue(G4UIcommand* command,
+                                              G4String newValue)
+{
+  if (command == fModeCmd) {
+    if (newValue == "lines") fAction->SetSourceMode(B1PrimaryGeneratorAction::kLines);
+    else                     fAction->SetSourceMode(B1PrimaryGeneratorAction::kIon);
+  }
+
+  if (command == fEventSeedsCmd) {
+    fAction->SetEventSeeding(fEventSeedsCmd->GetNewIntValue(newValue));
+  }
+
+  if (command == fFirstEventCmd) {
+    fAction->SetFirstEvent(fFirstEventCmd->GetNewIntValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,306 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1Profiler.cc
+/// \brief Implementation of the B1Profiler class
+
+#include "B1Profiler.hh"
+#include "B1ProfilerMessenger.hh"
+
+#include "G4Step.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4VProcess.hh"
+#include "G4Threading.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+namespace {
+  // event time histogram: 20 bins per decade from 0.1 us
+  const G4int    kBinsPerDecade = 20;
+  const G4int    kNofTimeBins   = 9*kBinsPerDecade;
+  const G4double kMinTime       = 1.e-7;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1Profiler::B1Profiler()
+ : G4VAccumulable("Profile"),
+   fMessenger(0),
+   fEnabled(false),
+   fStepTiming(true),
+   fFileName("B1profile.json"),
+   fNofEvents(0),
+   fEventTimeBins(kNofTimeBins, 0)
+{
+  fMessenger = new B1ProfilerMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1Profiler::~B1Profiler()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1Profiler::Merge(const G4VAccumulable& other)
+{
+  const B1Profiler& otherProfiler = static_cast<const B1Profiler&>(other);
+
+  MergeTable(fVolumes,   otherProfiler.fVolumes);
+  MergeTable(fParticles, otherProfiler.fParticles);
+  MergeTable(fProcesses, otherProfiler.fProcesses);
+  for (G4int i = 0; i < kNofPhases; ++i) {
+    fPhases[i].fCount += otherProfiler.fPhases[i].fCount;
+    fPhases[i].fTime  += otherProfiler.fPhases[i].fTime;
+  }
+  fNofEvents += otherProfiler.fNofEvents;
+  for (G4int i = 0; i < kNofTimeBins; ++i) {
+    fEventTimeBins[i] += otherProfiler.fEventTimeBins[i];
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1Profiler::Reset()
+{
+  fVolumeCounters.clear();
+  fParticleCounters.clear();
+  fProcessCounters.clear();
+  fVolumes.clear();
+  fParticles.clear();
+  fProcesses.clear();
+  for (G4int i = 0; i < kNofPhases; ++i) fPhases[i] = Counter();
+  fNofEvents = 0;
+  std::fill(fEventTimeBins.begin(), fEventTimeBins.end(), 0);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1Profiler::EndEvent()
+{
+  if ( ! fEnabled ) return;
+  G4double time =
+    std::chrono::duration<G4double>(Clock::now() - fEventStart).count();
+  G4int bin = time > kMinTime ?
+    G4int(kBinsPerDecade*std::log10(time/kMinTime)) : 0;
+  fEventTimeBins[std::min(bin, kNofTimeBins-1)] += 1;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1Profiler::GetEventTimePercentile(G4double fraction) const
+{
+  G4long total = 0;
+  for (G4int i = 0; i < kNofTimeBins; ++i) total += fEventTimeBins[i];
+  if (total == 0) return 0.;
+
+  // geometric centre of the bin holding the requested fraction
+  G4long count = 0;
+  for (G4int i = 0; i < kNofTimeBins; ++i) {
+    count += fEventTimeBins[i];
+    if (count >= fraction*total) {
+      return kMinTime*std::pow(10., (i + 0.5)/kBinsPerDecade);
+    }
+  }
+  return kMinTime*std::pow(10., G4double(kNofTimeBins)/kBinsPerDecade);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1Profiler::AddStep(const G4Step* step)
+{
+  Clock::time_point now = Clock::now();
+  G4double time = std::chrono::duration<G4double>(now - fStepStamp).count();
+  fStepStamp = now;
+
+  Counter& volume = fVolumeCounters[step->GetPreStepPoint()->GetPhysicalVolume()];
+  volume.fCount += 1;
+  volume.fTime  += time;
+
+  Counter& particle = fParticleCounters[step->GetTrack()->GetDefinition()];
+  particle.fCount += 1;
+  particle.fTime  += time;
+
+  Counter& process =
+    fProcessCounters[step->GetPostStepPoint()->GetProcessDefinedStep()];
+  process.fCount += 1;
+  process.fTime  += time;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1Profiler::Fold()
+{
+  for (auto it = fVolumeCounters.begin(); it != fVolumeCounters.end(); ++it) {
+    Counter& counter = fVolumes[it->first ? it->first->GetName() : "OutOfWorld"];
+    counter.fCount += it->second.fCount;
+    counter.fTime  += it->second.fTime;
+  }
+  for (auto it = fParticleCounters.begin(); it != fParticleCounters.end(); ++it) {
+    Counter& counter = fParticles[it->first->GetParticleName()];
+    counter.fCount += it->second.fCount;
+    counter.fTime  += it->second.fTime;
+  }
+  for (auto it = fProcessCounters.begin(); it != fProcessCounters.end(); ++it) {
+    Counter& counter = fProcesses[it->first ? it->first->GetProcessName() : "none"];
+    counter.fCount += it->second.fCount;
+    counter.fTime  += it->second.fTime;
+  }
+  fVolumeCounters.clear();
+  fParticleCounters.clear();
+  fProcessCounters.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1Profiler::MergeTable(Table& to, const Table& from)
+{
+  for (Table::const_iterator it = from.begin(); it != from.end(); ++it) {
+    to[it->first].fCount += it->second.fCount;
+    to[it->first].fTime  += it->second.fTime;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1Profiler::Report() const
+{
+  if ( ! fEnabled || fNofEvents == 0 ) return;
+
+  static const char* phaseNames[kNofPhases]
+    = { "generation", "tracking", "scoring", "fill" };
+
+  G4double eventTime = 0.;
+  for (G4int i = 0; i < kNofPhases; ++i) eventTime += fPhases[i].fTime;
+  G4double trackingTime = fPhases[kTracking].fTime;
+
+  G4cout
+    << G4endl
+    << "--------------------Profile of the Run----------------------"
+    << G4endl
+    << " " << fNofEvents << " events, "
+    << std::setprecision(4) << eventTime << " s summed over threads, "
+    << eventTime/fNofEvents*1.e6 << " us/event"
+    << G4endl
+    << " event time percentiles (us): 50% "
+    << GetEventTimePercentile(0.5)*1.e6
+    << ", 90% " << GetEventTimePercentile(0.9)*1.e6
+    << ", 99% " << GetEventTimePercentile(0.99)*1.e6
+    << G4endl;
+
+  Table phases;
+  for (G4int i = 0; i < kNofPhases; ++i) phases[phaseNames[i]] = fPhases[i];
+  PrintTable(G4cout, "phase", phases, eventTime);
+  PrintTable(G4cout, "volume", fVolumes, trackingTime);
+  PrintTable(G4cout, "particle", fParticles, trackingTime);
+  PrintTable(G4cout, "process", fProcesses, trackingTime);
+  G4cout
+    << "------------------------------------------------------------"
+    << G4endl;
+
+  std::ofstream file(fFileName);
+  if ( ! file ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open " << fFileName << " for writing.";
+    G4Exception("B1Profiler::Report()","B1Profile0001",JustWarning,msg);
+    return;
+  }
+  file << std::setprecision(9)
+       << "{\n"
+       << "  \"events\": " << fNofEvents << ",\n"
+       << "  \"threads\": "
+       << std::max(G4Threading::GetNumberOfRunningWorkerThreads(), 1) << ",\n"
+       << "  \"time_unit\": \"s\",\n"
+       << "  \"event_time_percentiles\": { \"50\": "
+       << GetEventTimePercentile(0.5)
+       << ", \"90\": " << GetEventTimePercentile(0.9)
+       << ", \"99\": " << GetEventTimePercentile(0.99) << " },\n";
+  WriteTable(file, "phases", phases);
+  file << ",\n";
+  WriteTable(file, "volumes", fVolumes);
+  file << ",\n";
+  WriteTable(file, "particles", fParticles);
+  file << ",\n";
+  WriteTable(file, "processes", fProcesses);
+  file << "\n}\n";
+
+  G4cout << " Profile written to " << fFileName << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1Profiler::PrintTable(std::ostream& os, const G4String& title,
+                            const Table& table, G4double totalTime) const
+{
+  // sorted by decreasing time
+  std::vector<std::pair<G4double, G4String> > order;
+  for (Table::const_iterator it = table.begin(); it != table.end(); ++it) {
+    order.push_back(std::make_pair(-it->second.fTime, it->first));
+  }
+  std::sort(order.begin(), order.end());
+
+  os << G4endl
+     << " " << std::left << std::setw(24) << title << std::right
+     << std::setw(14) << "calls"
+     << std::setw(12) << "time [s]"
+     << std::setw(9)  << "[%]"
+     << std::setw(12) << "[ns/call]" << G4endl;
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    const Counter& counter = table.find(order[i].second)->second;
+    os << " " << std::left << std::setw(24) << order[i].second << std::right
+       << std::setw(14) << counter.fCount
+       << std::fixed
+       << std::setw(12) << std::setprecision(3) << counter.fTime
+       << std::setw(9)  << std::setprecision(1)
+       << (totalTime > 0. ? 100.*counter.fTime/totalTime : 0.)
+       << std::setw(12) << std::setprecision(0)
+       << (counter.fCount > 0 ? 1.e9*counter.fTime/counter.fCount : 0.)
+       << std::defaultfloat << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1Profiler::WriteTable(std::ostream& os, const G4String& title,
+                            const Table& table) const
+{
+  os << "  \"" << title << "\": {";
+  for (Table::const_iterator it = table.begin(); it != table.end(); ++it) {
+    os << (it == table.begin() ? "\n" : ",\n")
+       << "    \"" << it->first << "\": { \"calls\": " << it->second.fCount
+       << ", \"time\": " << it->second.fTime << " }";
+  }
+  os << "\n  }";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,94 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1ProfilerMessenger.cc
+/// \brief Implementation of the B1ProfilerMessenger class
+
+#include "B1ProfilerMessenger.hh"
+#include "B1Profiler.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ProfilerMessenger::B1ProfilerMessenger(B1Profiler* profiler)
+ : G4UImessenger(),
+   fProfiler(profiler),
+   fProfileDir(0),
+   fEnableCmd(0), fStepsCmd(0), fFileNameCmd(0)
+{
+  fProfileDir = new G4UIdirectory("/B1/profile/");
+  fProfileDir->SetGuidance("Timing of the simulation");
+
+  fEnableCmd = new G4UIcmdWithABool("/B1/profile/enable",this);
+  fEnableCmd->SetGuidance("Time the event phases and the steps per volume,");
+  fEnableCmd->SetGuidance("particle and process; report at the end of run.");
+  fEnableCmd->SetParameterName("flag",true);
+  fEnableCmd->SetDefaultValue(true);
+  fEnableCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fStepsCmd = new G4UIcmdWithABool("/B1/profile/steps",this);
+  fStepsCmd->SetGuidance("Time the steps per volume, particle and process");
+  fStepsCmd->SetGuidance("(on by default). Without, only the event phases are timed.");
+  fStepsCmd->SetParameterName("flag",true);
+  fStepsCmd->SetDefaultValue(true);
+  fStepsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fFileNameCmd = new G4UIcmdWithAString("/B1/profile/fileName",this);
+  fFileNameCmd->SetGuidance("Set the name of the JSON profile report.");
+  fFileNameCmd->SetParameterName("name",false);
+  fFileNameCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ProfilerMessenger::~B1ProfilerMessenger()
+{
+  delete fFileNameCmd;
+  delete fStepsCmd;
+  delete fEnableCmd;
+  delete fProfileDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ProfilerMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fEnableCmd) {
+    fProfiler->SetEnabled(fEnableCmd->GetNewBoolValue(newValue));
+  }
+
+  if (command == fStepsCmd) {
+    fProfiler->SetStepTiming(fStepsCmd->GetNewBoolValue(newValue));
+  }
+
+  if (command == fFileNameCmd) {
+    fProfiler->SetFileName(newValue);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,68 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1ResolutionFolder.cc
+/// \brief Implementation of the B1ResolutionFolder class
+
+#include "B1ResolutionFolder.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "G4PhysicalConstants.hh"
+#include "Randomize.hh"
+
+#include <cmath>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ResolutionFolder::B1ResolutionFolder()
+ : fFano(0.11), fPairEnergy(2.96*eV), fNoiseFwhm(150.*eV)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ResolutionFolder::~B1ResolutionFolder()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1ResolutionFolder::GetSigma(G4double energy) const
+{
+  const G4double fwhmToSigma = 1./(2.*std::sqrt(2.*std::log(2.)));
+  G4double noise = fNoiseFwhm*fwhmToSigma;
+  return std::sqrt(noise*noise + fFano*fPairEnergy*energy);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1ResolutionFolder::Fold(G4double energy) const
+{
+  G4double u[2];
+  G4Random::getTheEngine()->flatArray(2, u);
+  // 1 - u is in (0,1], so the logarithm is finite
+  G4double gauss = std::sqrt(-2.*std::log(1. - u[0]))*std::cos(twopi*u[1]);
+  return energy + GetSigma(energy)*gauss;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
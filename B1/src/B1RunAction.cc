@@ -31,9 +31,15 @@
 #include "B1PrimaryGeneratorAction.hh"
 #include "B1DetectorConstruction.hh"
 #include "B1HistoManager.hh"
+#include "B1Profiler.hh"
+#include "B1RunSummary.hh"
+#include "B1TrackingAction.hh"
+#include "B1SteppingAction.hh"
 // #include "B1Run.hh"
 
 #include "G4RunManager.hh"
+#include "G4EventManager.hh"
+#include "G4TrackingManager.hh"
 #include "G4Run.hh"
 #include "G4AccumulableManager.hh"
 #include "G4LogicalVolumeStore.hh"
@@ -43,43 +49,119 @@
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-B1RunAction::B1RunAction(HistoManager* histo)
+B1RunAction::B1RunAction(HistoManager* histo, B1Profiler* profiler,
+                         B1StopCondition* stop, B1ScanScheduler* scan)
 : G4UserRunAction(),
   fHistoManager(histo),
+  fProfiler(profiler),
+  fTrackingAction(0),
+  fSteppingAction(0),
+  fGenerator(0),
   fEdep(0.),
-  fEdep2(0.)
+  fEdep2(0.),
+  fEventEdep(0.),
+  fNofTriggered(0),
+  fStop(stop),
+  fStopSums(),
+  fScan(scan),
+  fScanSums()
 { 
   G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
   accumulableManager->RegisterAccumulable(fEdep);
   accumulableManager->RegisterAccumulable(fEdep2); 
+  accumulableManager->RegisterAccumulable(fNofTriggered); 
+  for (G4int i = 0; i < B1StackFilter::kNofCounters; ++i) {
+    accumulableManager->RegisterAccumulable(fNofStacked[i]);
+  }
+  accumulableManager->RegisterAccumulable(fProfiler);
+  accumulableManager->RegisterAccumulable(fHistoManager->GetSparseSpectra());
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1RunAction::~B1RunAction()
-{}
+{
+  delete fSteppingAction;
+  delete fTrackingAction;
+  delete fProfiler;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RunAction::SetTrackingActions(B1TrackingAction* trackingAction,
+                                     B1SteppingAction* steppingAction)
+{
+  fTrackingAction = trackingAction;
+  fSteppingAction = steppingAction;
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 void B1RunAction::BeginOfRunAction(const G4Run*)
 { 
   // inform the runManager to save random number seed
-  G4RunManager::GetRunManager()->SetRandomNumberStore(false);
+  G4RunManager* runManager = G4RunManager::GetRunManager();
+  runManager->SetRandomNumberStore(false);
+
+  // the tracking and stepping actions, for this run only if needed
+  if (fTrackingAction && fTrackingAction->IsNeeded()) {
+    runManager->SetUserAction(fTrackingAction);
+  }
+  if (fSteppingAction && fSteppingAction->IsNeeded()) {
+    fSteppingAction->BeginOfRun();
+    runManager->SetUserAction(fSteppingAction);
+  }
+
+#ifdef B1_BATCH
+  // no viewer in the batch executable: never store trajectories, whatever
+  // a macro sets with /tracking/storeTrajectory; the workers execute the
+  // macro commands before their run starts
+  G4EventManager::GetEventManager()->GetTrackingManager()
+    ->SetStoreTrajectory(0);
+#endif
 
   // reset accumulables to their initial values
   G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
   accumulableManager->Reset();
   fHistoManager->Book(); 
+
+  // the master resets the shared totals before the workers start
+  fEventEdep = 0.;
+  fStopSums = B1StopCondition::Sums();
+  if (IsMaster()) fStop->Reset();
+  fScanSums = B1ScanScheduler::Sums();
+  if (IsMaster() && fScan->IsActive()) fScan->Reset();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 void B1RunAction::EndOfRunAction(const G4Run* run)
 {
+  // uninstall the tracking and stepping actions: they are owned here,
+  // not by the kernel
+  G4RunManager* runManager = G4RunManager::GetRunManager();
+  if (fTrackingAction) {
+    runManager->SetUserAction(static_cast<G4UserTrackingAction*>(0));
+  }
+  if (fSteppingAction) {
+    runManager->SetUserAction(static_cast<G4UserSteppingAction*>(0));
+  }
+
+  // the next run continues the event numbers of the per-event seeding,
+  // by the number of events requested, the same on all threads
+  if (fGenerator) {
+    fGenerator->AdvanceFirstEvent(run->GetNumberOfEventToBeProcessed());
+  }
+
+  // the events since the last check of this thread
+  if (fStop->IsActive()) fStop->Publish(fStopSums);
+  if (fScan->IsActive()) fScan->Publish(fScanSums);
+
   G4int nofEvents = run->GetNumberOfEvent();
   if (nofEvents == 0) return;
 
   // Merge accumulables 
+  fProfiler->Fold();
   G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
   accumulableManager->Merge();
 
@@ -109,15 +191,107 @@ void B1RunAction::EndOfRunAction(const G4Run* run)
     G4double particleEnergy = particleGun->GetParticleEnergy();
     runCondition += G4BestUnit(particleEnergy,"Energy");
   }
+
+  if (IsMaster()) {
+    G4cout
+     << G4endl
+     << "--------------------End of Global Run-----------------------"
+     << G4endl
+     << " The run consists of " << nofEvents << " events, "
+     << fNofTriggered.GetValue() << " of them above the trigger threshold"
+     << G4endl
+     << "------------------------------------------------------------"
+     << G4endl;
+
+    // the deferred tracks are still tracked: they are not counted as killed
+    G4int nofKilled = 0;
+    for (G4int i = 0; i < B1StackFilter::kNofCounters; ++i) {
+      if (i == B1StackFilter::kRuleDefer) continue;
+      nofKilled += fNofStacked[i].GetValue();
+    }
+    G4int nofDeferred = fNofStacked[B1StackFilter::kRuleDefer].GetValue();
+    if (nofKilled > 0) {
+      G4cout << " Stacking filter: " << nofKilled << " tracks killed:";
+      for (G4int i = 0; i < B1StackFilter::kNofCounters; ++i) {
+        if (i == B1StackFilter::kRuleDefer) continue;
+        if (fNofStacked[i].GetValue() == 0) continue;
+        G4cout << "  " << fNofStacked[i].GetValue() << " "
+               << B1StackFilter::GetCounterName(i);
+      }
+      G4cout << G4endl;
+    }
+    if (nofDeferred > 0) {
+      G4cout << " Stacking filter: " << nofDeferred
+             << " tracks deferred to the waiting stack" << G4endl;
+    }
+
+    fStop->Report();
+    fHistoManager->PrintScan();
+    fScan->Report();
+    fProfiler->Report();
+  }
+
+  fHistoManager->SetNofEvents(nofEvents);
+  if (IsMaster() && fHistoManager->GetSummaryFileName() != "") {
+    B1RunSummary summary;
+    summary.SetRun(nofEvents, fNofTriggered.GetValue(), edep, edep2);
+    fHistoManager->FillSummary(summary);
+    summary.Write(fHistoManager->GetSummaryFileName());
+  }
   fHistoManager->Save();  
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void B1RunAction::AddEdep(G4double edep)
+void B1RunAction::AddEdep(G4double edep, G4double weight)
+{
+  fEdep      += weight*edep;
+  fEventEdep += weight*edep;
+  if (fStop->IsActive()) fStop->Fill(fStopSums, edep, weight);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RunAction::EndEvent()
+{
+  // the variance takes the weighted Edep of the whole event, the sum of
+  // its alternatives under importance sampling
+  fEdep2 += fEventEdep*fEventEdep;
+  fEventEdep = 0.;
+  if (fStop->IsActive()) fStop->EndEvent(fStopSums);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RunAction::AddScanEdep(G4int point, G4double edep, G4double weight)
 {
-  fEdep  += edep;
-  fEdep2 += edep*edep;
+  if (! fScan->IsActive()) return;
+
+  // one publication per batch: on a change of point or a full batch
+  if (point != fScanSums.fPoint ||
+      fScanSums.fNofEvents >= fScan->GetBatchSize()) {
+    fScan->Publish(fScanSums);
+    fScanSums.fPoint = point;
+  }
+  G4double x = weight*edep;
+  fScanSums.fNofEvents++;
+  fScanSums.fSx  += x;
+  fScanSums.fSx2 += x*x;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RunAction::CheckStop()
+{
+  // soft abort: the event loop of this thread ends after this event
+  if (fStop->IsActive() &&
+      (fStop->IsReached() ||
+       (fStop->IsCheckDue(fStopSums) && fStop->Publish(fStopSums)))) {
+    G4RunManager::GetRunManager()->AbortRun(true);
+  }
+  else if (fScan->IsActive() && fScan->IsDone()) {
+    G4RunManager::GetRunManager()->AbortRun(true);
+  }
 }
 
 
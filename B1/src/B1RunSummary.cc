@@ -0,0 +1,238 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1RunSummary.cc
+/// \brief Implementation of the B1RunSummary class
+
+#include "B1RunSummary.hh"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+G4double ReadDouble(std::istream& is)
+{
+  // operator>> does not parse hexfloat with all standard libraries
+  std::string token;
+  is >> token;
+  return std::strtod(token.c_str(), 0);
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1RunSummary::B1RunSummary()
+: fNofEvents(0),
+  fNofTriggered(0),
+  fEdep(0.),
+  fEdep2(0.),
+  fHistos()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1RunSummary::~B1RunSummary()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RunSummary::SetRun(G4int nofEvents, G4int nofTriggered,
+                          G4double edep, G4double edep2)
+{
+  fNofEvents = nofEvents;
+  fNofTriggered = nofTriggered;
+  fEdep = edep;
+  fEdep2 = edep2;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RunSummary::AddHisto(const G4String& name, const G4String& title,
+                            const tools::histo::h1d& h1)
+{
+  Histo histo;
+  histo.fName = name;
+  histo.fTitle = title;
+  histo.fNbins = h1.axis().bins();
+  histo.fXmin = h1.axis().lower_edge();
+  histo.fXmax = h1.axis().upper_edge();
+  // the only variable binning booked by HistoManager is the log one
+  histo.fLog = ! h1.axis().is_fixed_binning();
+  histo.fEntries = h1.bins_entries();
+  histo.fSw = h1.bins_sum_w();
+  histo.fSw2 = h1.bins_sum_w2();
+  for (std::size_t i = 0; i < histo.fEntries.size(); ++i) {
+    histo.fSxw.push_back(h1.bins_sum_xw()[i][0]);
+    histo.fSx2w.push_back(h1.bins_sum_x2w()[i][0]);
+  }
+  fHistos.push_back(histo);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1RunSummary::Write(const G4String& fileName) const
+{
+  std::ofstream file(fileName.c_str());
+  if (! file) {
+    G4ExceptionDescription msg;
+    msg << "Cannot write the run summary " << fileName;
+    G4Exception("B1RunSummary::Write()", "B1Summary0001", JustWarning, msg);
+    return false;
+  }
+
+  file << "# B1 run summary, doubles in hexadecimal floating point\n"
+       << std::hexfloat
+       << "events " << fNofEvents << "\n"
+       << "triggered " << fNofTriggered << "\n"
+       << "edep " << fEdep << "\n"
+       << "edep2 " << fEdep2 << "\n";
+  for (std::size_t ih = 0; ih < fHistos.size(); ++ih) {
+    const Histo& histo = fHistos[ih];
+    // only the filled bins, the title last as it contains blanks
+    std::size_t nofFilled = 0;
+    for (std::size_t i = 0; i < histo.fEntries.size(); ++i) {
+      if (histo.fEntries[i] > 0) ++nofFilled;
+    }
+    file << ( histo.fLog ? "h1log " : "h1 " ) << histo.fName << " " << histo.fNbins << " "
+         << histo.fXmin << " " << histo.fXmax << " " << nofFilled << " "
+         << histo.fTitle << "\n";
+    for (std::size_t i = 0; i < histo.fEntries.size(); ++i) {
+      if (histo.fEntries[i] == 0) continue;
+      file << i << " " << histo.fEntries[i] << " "
+           << histo.fSw[i] << " " << histo.fSw2[i] << " "
+           << histo.fSxw[i] << " " << histo.fSx2w[i] << "\n";
+    }
+  }
+  return file.good();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1RunSummary::Read(const G4String& fileName)
+{
+  std::ifstream file(fileName.c_str());
+  if (! file) return false;
+
+  *this = B1RunSummary();
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream is(line);
+    std::string key;
+    is >> key;
+    if      (key == "events")    is >> fNofEvents;
+    else if (key == "triggered") is >> fNofTriggered;
+    else if (key == "edep")      fEdep = ReadDouble(is);
+    else if (key == "edep2")     fEdep2 = ReadDouble(is);
+    else if (key == "h1" || key == "h1log") {
+      Histo histo;
+      histo.fLog = (key == "h1log");
+      std::size_t nofFilled = 0;
+      is >> histo.fName >> histo.fNbins;
+      histo.fXmin = ReadDouble(is);
+      histo.fXmax = ReadDouble(is);
+      is >> nofFilled >> std::ws;
+      std::getline(is, histo.fTitle);
+      if (! is && ! is.eof()) return false;
+
+      std::size_t size = histo.fNbins + 2;
+      histo.fEntries.assign(size, 0);
+      histo.fSw.assign(size, 0.);
+      histo.fSw2.assign(size, 0.);
+      histo.fSxw.assign(size, 0.);
+      histo.fSx2w.assign(size, 0.);
+      for (std::size_t n = 0; n < nofFilled; ++n) {
+        if (! std::getline(file, line)) return false;
+        std::istringstream bin(line);
+        std::size_t i = size;
+        bin >> i;
+        if (i >= size) return false;
+        bin >> histo.fEntries[i];
+        histo.fSw[i] = ReadDouble(bin);
+        histo.fSw2[i] = ReadDouble(bin);
+        histo.fSxw[i] = ReadDouble(bin);
+        histo.fSx2w[i] = ReadDouble(bin);
+      }
+      fHistos.push_back(histo);
+    }
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1RunSummary::Add(const B1RunSummary& other)
+{
+  if (other.fHistos.size() != fHistos.size()) return false;
+  for (std::size_t ih = 0; ih < fHistos.size(); ++ih) {
+    const Histo& a = fHistos[ih];
+    const Histo& b = other.fHistos[ih];
+    if (a.fName != b.fName || a.fNbins != b.fNbins ||
+        a.fXmin != b.fXmin || a.fXmax != b.fXmax ||
+        a.fLog != b.fLog) return false;
+  }
+
+  fNofEvents += other.fNofEvents;
+  fNofTriggered += other.fNofTriggered;
+  fEdep += other.fEdep;
+  fEdep2 += other.fEdep2;
+  for (std::size_t ih = 0; ih < fHistos.size(); ++ih) {
+    Histo& a = fHistos[ih];
+    const Histo& b = other.fHistos[ih];
+    for (std::size_t i = 0; i < a.fEntries.size(); ++i) {
+      a.fEntries[i] += b.fEntries[i];
+      a.fSw[i] += b.fSw[i];
+      a.fSw2[i] += b.fSw2[i];
+      a.fSxw[i] += b.fSxw[i];
+      a.fSx2w[i] += b.fSx2w[i];
+    }
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RunSummary::BookHistos(G4AnalysisManager* analysisManager) const
+{
+  for (std::size_t ih = 0; ih < fHistos.size(); ++ih) {
+    const Histo& histo = fHistos[ih];
+    G4int id = analysisManager->CreateH1(histo.fName, histo.fTitle,
+                                         histo.fNbins, histo.fXmin, histo.fXmax,
+                                         "none", "none",
+                                         histo.fLog ? "log" : "linear");
+    tools::histo::h1d* h1 = analysisManager->GetH1(id, false);
+    if (! h1) continue;
+    for (std::size_t i = 0; i < histo.fEntries.size(); ++i) {
+      if (histo.fEntries[i] == 0) continue;
+      h1->set_bin_content(i, histo.fEntries[i], histo.fSw[i], histo.fSw2[i],
+                          histo.fSxw[i], histo.fSx2w[i]);
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
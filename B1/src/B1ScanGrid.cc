@@ -0,0 +1,90 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1ScanGrid.cc
+/// \brief Implementation of the B1ScanGrid class
+
+#include "B1ScanGrid.hh"
+#include "B1ScanMessenger.hh"
+#include "B1ScanScheduler.hh"
+
+#include "G4SystemOfUnits.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ScanGrid::B1ScanGrid()
+: fMessenger(0),
+  fScheduler(0),
+  fEnabled(false),
+  fConeAngle(0.)
+{
+  // default: the fixed source position of B1PrimaryGeneratorAction
+  for (G4int axis = 0; axis < 3; ++axis) {
+    fMin[axis] = fMax[axis] = 0.;
+    fN[axis] = 1;
+  }
+  fMin[2] = fMax[2] = -0.2*cm;
+
+  fScheduler = new B1ScanScheduler(this);
+  fMessenger = new B1ScanMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ScanGrid::~B1ScanGrid()
+{
+  delete fMessenger;
+  delete fScheduler;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ScanGrid::SetAxis(G4int axis, G4double min, G4double max, G4int n)
+{
+  if (axis < 0 || axis > 2 || n < 1) return;
+  fMin[axis] = min;
+  fMax[axis] = max;
+  fN[axis] = n;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1ScanGrid::GetValue(G4int axis, G4int i) const
+{
+  if (fN[axis] == 1) return fMin[axis];
+  return fMin[axis] + i*(fMax[axis] - fMin[axis])/(fN[axis] - 1);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4ThreeVector B1ScanGrid::GetPosition(G4int point) const
+{
+  G4int ix = point % fN[0];
+  G4int iy = (point / fN[0]) % fN[1];
+  G4int iz = point / (fN[0]*fN[1]);
+  return G4ThreeVector(GetValue(0, ix), GetValue(1, iy), GetValue(2, iz));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
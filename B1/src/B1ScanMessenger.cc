@@ -0,0 +1,162 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1ScanMessenger.cc
+/// \brief Implementation of the B1ScanMessenger class
+
+#include "B1ScanMessenger.hh"
+#include "B1ScanGrid.hh"
+#include "B1ScanScheduler.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4Tokenizer.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ScanMessenger::B1ScanMessenger(B1ScanGrid* grid)
+ : G4UImessenger(),
+   fGrid(grid),
+   fScanDir(0),
+   fEnableCmd(0),
+   fConeCmd(0),
+   fAdaptiveCmd(0),
+   fBatchSizeCmd(0)
+{
+  fScanDir = new G4UIdirectory("/B1/scan/");
+  fScanDir->SetGuidance("Scan of the source position in a single run");
+
+  fEnableCmd = new G4UIcmdWithABool("/B1/scan/enable",this);
+  fEnableCmd->SetGuidance("Place the source of each event on a point of the grid");
+  fEnableCmd->SetGuidance("and score the spectra per point (ESpecScan).");
+  fEnableCmd->SetParameterName("flag",true);
+  fEnableCmd->SetDefaultValue(true);
+  fEnableCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fEnableCmd->SetToBeBroadcasted(false);
+
+  fAxisCmd[0] = CreateAxisCommand("x");
+  fAxisCmd[1] = CreateAxisCommand("y");
+  fAxisCmd[2] = CreateAxisCommand("z");
+
+  fConeCmd = new G4UIcmdWithADoubleAndUnit("/B1/scan/cone",this);
+  fConeCmd->SetGuidance("Emit the line source in a cone of this half angle");
+  fConeCmd->SetGuidance("around +z, weighted by its solid angle; 0: isotropic.");
+  fConeCmd->SetParameterName("halfAngle",false);
+  fConeCmd->SetRange("halfAngle>=0.");
+  fConeCmd->SetUnitCategory("Angle");
+  fConeCmd->SetDefaultUnit("deg");
+  fConeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fConeCmd->SetToBeBroadcasted(false);
+
+  fAdaptiveCmd = new G4UIcmdWithADouble("/B1/scan/adaptive",this);
+  fAdaptiveCmd->SetGuidance("Hand out the events in batches, to the point with the");
+  fAdaptiveCmd->SetGuidance("largest relative error on its mean Edep per event, and");
+  fAdaptiveCmd->SetGuidance("stop the run once all points reach this relative error.");
+  fAdaptiveCmd->SetGuidance("0: the points get equal numbers of events.");
+  fAdaptiveCmd->SetParameterName("relError",false);
+  fAdaptiveCmd->SetRange("relError>=0.");
+  fAdaptiveCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fAdaptiveCmd->SetToBeBroadcasted(false);
+
+  fBatchSizeCmd = new G4UIcmdWithAnInteger("/B1/scan/batchSize",this);
+  fBatchSizeCmd->SetGuidance("Number of events of one point handed out at once");
+  fBatchSizeCmd->SetGuidance("by the adaptive scan.");
+  fBatchSizeCmd->SetParameterName("nofEvents",false);
+  fBatchSizeCmd->SetRange("nofEvents>0");
+  fBatchSizeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fBatchSizeCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ScanMessenger::~B1ScanMessenger()
+{
+  delete fBatchSizeCmd;
+  delete fAdaptiveCmd;
+  delete fConeCmd;
+  for (G4int axis = 0; axis < 3; ++axis) delete fAxisCmd[axis];
+  delete fEnableCmd;
+  delete fScanDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4UIcommand* B1ScanMessenger::CreateAxisCommand(const G4String& axis)
+{
+  G4UIcommand* command = new G4UIcommand("/B1/scan/" + axis, this);
+  command->SetGuidance("Set the " + axis + " values of the grid: n values from min");
+  command->SetGuidance("to max, or min alone with n = 1.");
+  G4UIparameter* minPrm = new G4UIparameter("min",'d',false);
+  command->SetParameter(minPrm);
+  G4UIparameter* maxPrm = new G4UIparameter("max",'d',false);
+  command->SetParameter(maxPrm);
+  G4UIparameter* nPrm = new G4UIparameter("n",'i',false);
+  nPrm->SetParameterRange("n>0");
+  command->SetParameter(nPrm);
+  G4UIparameter* unitPrm = new G4UIparameter("unit",'s',true);
+  unitPrm->SetDefaultUnit("mm");
+  command->SetParameter(unitPrm);
+  command->AvailableForStates(G4State_PreInit,G4State_Idle);
+  command->SetToBeBroadcasted(false);
+  return command;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ScanMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fEnableCmd) {
+    fGrid->SetEnabled(fEnableCmd->GetNewBoolValue(newValue));
+  }
+
+  for (G4int axis = 0; axis < 3; ++axis) {
+    if (command != fAxisCmd[axis]) continue;
+    G4Tokenizer next(newValue);
+    G4double min = G4UIcommand::ConvertToDouble(next());
+    G4double max = G4UIcommand::ConvertToDouble(next());
+    G4int n = G4UIcommand::ConvertToInt(next());
+    G4double unit = G4UIcommand::ValueOf(next());
+    fGrid->SetAxis(axis, min*unit, max*unit, n);
+  }
+
+  if (command == fConeCmd) {
+    fGrid->SetConeAngle(fConeCmd->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fAdaptiveCmd) {
+    fGrid->GetScheduler()->SetPrecision(fAdaptiveCmd->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fBatchSizeCmd) {
+    fGrid->GetScheduler()->SetBatchSize(fBatchSizeCmd->GetNewIntValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,181 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1ScanScheduler.cc
+/// \brief Implementation of the B1ScanScheduler class
+
+#include "B1ScanScheduler.hh"
+#include "B1ScanGrid.hh"
+
+#include "G4AutoLock.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ios.hh"
+
+#include <cmath>
+#include <iomanip>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ScanScheduler::B1ScanScheduler(const B1ScanGrid* grid)
+: fGrid(grid),
+  fPrecision(0.),
+  fBatchSize(1000),
+  fMutex(),
+  fDone(false),
+  fRunIndex(0)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ScanScheduler::~B1ScanScheduler()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1ScanScheduler::IsActive() const
+{
+  return fPrecision > 0. && fGrid->IsActive();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ScanScheduler::Reset()
+{
+  G4AutoLock lock(&fMutex);
+  G4int nofPoints = fGrid->GetNofPoints();
+  fNofEvents.assign(nofPoints, 0);
+  fPending.assign(nofPoints, 0);
+  fSx.assign(nofPoints, 0.);
+  fSx2.assign(nofPoints, 0.);
+  fDone = false;
+  // the threads drop the batches of the previous run
+  fRunIndex++;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1ScanScheduler::RelativeError(G4int point) const
+{
+  G4int n = fNofEvents[point];
+  if (n < 2 || fSx[point] <= 0.) return -1.;
+  G4double mean = fSx[point]/n;
+  G4double variance = (fSx2[point]/n - mean*mean)*n/(n - 1);
+  if (variance < 0.) variance = 0.;
+  return std::sqrt(variance/n)/mean;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int B1ScanScheduler::NextBatch()
+{
+  G4AutoLock lock(&fMutex);
+  G4int nofPoints = fNofEvents.size();
+  if (nofPoints == 0) return 0;
+
+  // first one batch per point
+  G4int next = -1;
+  for (G4int point = 0; point < nofPoints && next < 0; ++point) {
+    if (fNofEvents[point] + fPending[point] < fBatchSize) next = point;
+  }
+
+  // then the largest uncertainty, scaled to the events handed out
+  if (next < 0) {
+    G4double largest = 0.;
+    G4double largestNow = 0.;
+    G4int    worst = 0;
+    for (G4int point = 0; point < nofPoints; ++point) {
+      G4double relError = RelativeError(point);
+      if (relError < 0.) continue;
+      G4int n = fNofEvents[point];
+      G4double expected = relError*std::sqrt(G4double(n)/(n + fPending[point]));
+      if (expected > largest) {
+        largest = expected;
+        next = point;
+      }
+      if (relError > largestNow) {
+        largestNow = relError;
+        worst = point;
+      }
+    }
+    // all points converge with the pending batches: keep the thread busy
+    // on the worst point until they are published
+    if (next < 0 || largest <= fPrecision) next = worst;
+  }
+
+  fPending[next] += fBatchSize;
+  return next;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ScanScheduler::Publish(Sums& sums)
+{
+  if (sums.fNofEvents == 0) return;
+
+  G4AutoLock lock(&fMutex);
+  G4int point = sums.fPoint;
+  if (point >= 0 && point < G4int(fNofEvents.size())) {
+    fNofEvents[point] += sums.fNofEvents;
+    fSx[point]  += sums.fSx;
+    fSx2[point] += sums.fSx2;
+    fPending[point] -= sums.fNofEvents;
+    if (fPending[point] < 0) fPending[point] = 0;
+  }
+  sums = Sums();
+
+  G4bool done = IsActive() && ! fNofEvents.empty();
+  for (std::size_t p = 0; p < fNofEvents.size() && done; ++p) {
+    G4double relError = RelativeError(p);
+    if (relError < 0.) done = fNofEvents[p] >= fBatchSize;
+    else               done = relError <= fPrecision;
+  }
+  if (done) fDone = true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ScanScheduler::Report() const
+{
+  if (! IsActive()) return;
+
+  G4cout << "\n Adaptive scan, target " << fPrecision << " on the mean Edep "
+         << "per event, " << ( IsDone() ? "reached" : "not reached" ) << ":"
+         << G4endl;
+  for (std::size_t point = 0; point < fNofEvents.size(); ++point) {
+    G4double relError = RelativeError(point);
+    G4cout << std::setw(6) << point << "  " << std::setw(10)
+           << fNofEvents[point] << " events";
+    if (relError >= 0.) {
+      G4cout << "  mean Edep " << fSx[point]/fNofEvents[point]/keV
+             << " keV  relative error " << relError;
+    }
+    else {
+      G4cout << "  no energy deposit";
+    }
+    G4cout << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
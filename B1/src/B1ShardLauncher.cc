@@ -0,0 +1,237 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1ShardLauncher.cc
+/// \brief Implementation of the B1ShardLauncher class
+
+#include "B1ShardLauncher.hh"
+#include "B1RunSummary.hh"
+
+#include "G4Threading.hh"
+#include "G4UnitsTable.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ShardLauncher::B1ShardLauncher(G4int nofShards, G4int nofEvents,
+                                 G4long seed, const G4String& output)
+: fNofShards(nofShards),
+  fNofEvents(nofEvents),
+  fSeed(seed),
+  fOutput(output),
+  fNofCpus(0),
+  fStatus(nofShards, -1)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ShardLauncher::~B1ShardLauncher()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int B1ShardLauncher::GetNofEvents(G4int shard) const
+{
+  return fNofEvents/fNofShards + ( shard < fNofEvents % fNofShards ? 1 : 0 );
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int B1ShardLauncher::GetFirstEvent(G4int shard) const
+{
+  G4int extra = fNofEvents % fNofShards;
+  return shard*(fNofEvents/fNofShards) + ( shard < extra ? shard : extra );
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String B1ShardLauncher::GetShardName(G4int shard) const
+{
+  std::ostringstream name;
+  name << fOutput << "_shard" << shard;
+  return name.str();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int B1ShardLauncher::Launch()
+{
+  G4cout << "Running " << fNofEvents << " events in " << fNofShards
+         << " processes, seed " << fSeed << G4endl;
+  for (G4int shard = 0; shard < fNofShards; ++shard) {
+    G4cout << "  shard " << shard << ": events " << GetFirstEvent(shard)
+           << " to " << GetFirstEvent(shard) + GetNofEvents(shard) - 1
+           << ", log in " << GetShardName(shard) << ".log" << G4endl;
+  }
+  // nothing buffered may be written twice by the children
+  std::cout.flush();
+  std::cerr.flush();
+  std::fflush(0);
+
+  std::vector<pid_t> pids(fNofShards, -1);
+  for (G4int shard = 0; shard < fNofShards; ++shard) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      StartShard(shard);
+      return shard;
+    }
+    if (pid < 0) {
+      G4ExceptionDescription msg;
+      msg << "Cannot fork shard " << shard;
+      G4Exception("B1ShardLauncher::Launch()", "B1Shard0001", JustWarning, msg);
+      continue;
+    }
+    pids[shard] = pid;
+  }
+
+  for (G4int shard = 0; shard < fNofShards; ++shard) {
+    if (pids[shard] < 0) continue;
+    int status = 0;
+    if (waitpid(pids[shard], &status, 0) == pids[shard] && WIFEXITED(status)) {
+      fStatus[shard] = WEXITSTATUS(status);
+    }
+  }
+  return -1;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ShardLauncher::StartShard(G4int shard)
+{
+  // Give the shard its slice of the CPUs, so that the shards do not
+  // compete for the same cores; with more shards than CPUs the mask
+  // is left as it is.
+  fNofCpus = 0;
+#ifdef __linux__
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+    std::vector<G4int> cpus;
+    for (G4int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &mask)) cpus.push_back(cpu);
+    }
+    G4int nofCpus = cpus.size();
+    if (nofCpus >= fNofShards) {
+      G4int first = shard*nofCpus/fNofShards;
+      G4int last = (shard + 1)*nofCpus/fNofShards;
+      CPU_ZERO(&mask);
+      for (G4int i = first; i < last; ++i) CPU_SET(cpus[i], &mask);
+      if (sched_setaffinity(0, sizeof(mask), &mask) == 0) {
+        fNofCpus = last - first;
+      }
+    }
+  }
+#endif
+  if (fNofCpus == 0) {
+    fNofCpus = std::max(1, G4Threading::G4GetNumberOfCores()/fNofShards);
+  }
+
+  // one log per shard rather than interleaved output
+  G4String logName = GetShardName(shard) + ".log";
+  int fd = open(logName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd >= 0) {
+    dup2(fd, 1);
+    dup2(fd, 2);
+    close(fd);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1ShardLauncher::Merge() const
+{
+  // fixed shard order, so the sums do not depend on the exit order
+  B1RunSummary merged;
+  G4bool ok = true;
+  for (G4int shard = 0; shard < fNofShards; ++shard) {
+    G4String name = GetShardName(shard);
+    B1RunSummary summary;
+    if (fStatus[shard] != 0) {
+      G4cerr << "Shard " << shard << " failed, see " << name << ".log" << G4endl;
+      ok = false;
+    }
+    else if (! summary.Read(name + ".sum")) {
+      G4cerr << "Cannot read " << name << ".sum" << G4endl;
+      ok = false;
+    }
+    else if (shard == 0) {
+      merged = summary;
+    }
+    else if (! merged.Add(summary)) {
+      G4cerr << name << ".sum does not match the other shards" << G4endl;
+      ok = false;
+    }
+  }
+  if (! ok) return false;
+
+  merged.Write(fOutput + ".sum");
+
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  analysisManager->SetHistoDirectoryName("histo");
+  if (analysisManager->OpenFile(fOutput)) {
+    merged.BookHistos(analysisManager);
+    analysisManager->Write();
+    analysisManager->CloseFile();
+  }
+  delete G4AnalysisManager::Instance();
+
+  G4int nofEvents = merged.GetNofEvents();
+  G4double edep = merged.GetEdep();
+  G4double rms = merged.GetEdep2() - edep*edep/nofEvents;
+  if (rms > 0.) rms = std::sqrt(rms); else rms = 0.;
+
+  G4cout
+     << G4endl
+     << "--------------------End of Sharded Run----------------------"
+     << G4endl
+     << " " << fNofShards << " shards, " << nofEvents << " events, "
+     << merged.GetNofTriggered() << " of them above the trigger threshold"
+     << G4endl
+     << " Edep in the scoring volume : " << G4BestUnit(edep,"Energy")
+     << " rms = " << G4BestUnit(rms,"Energy")
+     << G4endl
+     << " Merged spectra in " << fOutput << ".root, summary in "
+     << fOutput << ".sum"
+     << G4endl
+     << "------------------------------------------------------------"
+     << G4endl;
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,144 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1SparseSpectra.cc
+/// \brief Implementation of the B1SparseSpectra class
+
+#include "B1SparseSpectra.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1SparseSpectra::B1SparseSpectra()
+: G4VAccumulable()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1SparseSpectra::~B1SparseSpectra()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1SparseSpectra::AddSpectrum(const G4String& name, G4double binWidth,
+                                  G4double emin, G4double emax)
+{
+  Spectrum spectrum;
+  spectrum.fName = name;
+  spectrum.fBinWidth = binWidth;
+  spectrum.fEmin = emin;
+  spectrum.fEmax = emax;
+  spectrum.fNbins = G4long(std::ceil((emax - emin)/binWidth));
+  fSpectra.push_back(spectrum);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1SparseSpectra::Clear()
+{
+  fSpectra.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1SparseSpectra::Merge(const G4VAccumulable& other)
+{
+  const B1SparseSpectra& otherSpectra
+    = static_cast<const B1SparseSpectra&>(other);
+
+  // the definitions are the same on all threads (broadcast commands)
+  std::size_t nofSpectra
+    = std::min(fSpectra.size(), otherSpectra.fSpectra.size());
+  for (std::size_t is = 0; is < nofSpectra; ++is) {
+    BinMap& to = fSpectra[is].fBins;
+    const BinMap& from = otherSpectra.fSpectra[is].fBins;
+    for (BinMap::const_iterator it = from.begin(); it != from.end(); ++it) {
+      Bin& bin = to[it->first];
+      bin.fEntries += it->second.fEntries;
+      bin.fSw  += it->second.fSw;
+      bin.fSw2 += it->second.fSw2;
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1SparseSpectra::Reset()
+{
+  for (std::size_t is = 0; is < fSpectra.size(); ++is) {
+    fSpectra[is].fBins.clear();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1SparseSpectra::Write(const G4String& baseName) const
+{
+  for (std::size_t is = 0; is < fSpectra.size(); ++is) {
+    const Spectrum& spectrum = fSpectra[is];
+    G4String fileName = baseName + "_" + spectrum.fName + ".txt";
+    std::ofstream file(fileName.c_str());
+    if (! file) {
+      G4ExceptionDescription msg;
+      msg << "Cannot write the sparse spectrum " << fileName;
+      G4Exception("B1SparseSpectra::Write()", "B1Sparse0001", JustWarning, msg);
+      continue;
+    }
+
+    // the filled bins in increasing energy
+    std::vector<G4long> indices;
+    indices.reserve(spectrum.fBins.size());
+    for (BinMap::const_iterator it = spectrum.fBins.begin();
+         it != spectrum.fBins.end(); ++it) {
+      indices.push_back(it->first);
+    }
+    std::sort(indices.begin(), indices.end());
+
+    file << "# " << spectrum.fName << ": " << spectrum.fNbins << " bins of "
+         << spectrum.fBinWidth/eV << " eV from " << spectrum.fEmin/keV
+         << " keV, " << indices.size() << " filled\n"
+         << "# bin (-1: underflow, " << spectrum.fNbins << ": overflow)"
+         << " low edge (keV) entries sum_w sum_w2\n";
+    file.precision(17);
+    for (std::size_t n = 0; n < indices.size(); ++n) {
+      const Bin& bin = spectrum.fBins.find(indices[n])->second;
+      G4double lowEdge = spectrum.fEmin + indices[n]*spectrum.fBinWidth;
+      file << indices[n] << " " << lowEdge/keV << " " << bin.fEntries << " "
+           << bin.fSw << " " << bin.fSw2 << "\n";
+    }
+
+    G4cout << "\n----> Sparse spectrum " << spectrum.fName << ", "
+           << indices.size() << " filled bins, written in " << fileName
+           << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,176 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1StackFilter.cc
+/// \brief Implementation of the B1StackFilter class
+
+#include "B1StackFilter.hh"
+#include "B1StackMessenger.hh"
+#include "B1TrackInformation.hh"
+
+#include "G4Track.hh"
+#include "G4Ions.hh"
+#include "G4ParticleTable.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4UnitsTable.hh"
+#include "G4ios.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StackFilter::B1StackFilter()
+: fMessenger(0),
+  fEnabled(true),
+  fKillNeutrinos(true),
+  fKillStableIons(true),
+  fTimeMin(0.),
+  fTimeMax(0.),
+  fRules()
+{
+  fMessenger = new B1StackMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StackFilter::~B1StackFilter()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StackFilter::SetTimeWindow(G4double tmin, G4double tmax)
+{
+  // tmax <= tmin: no time window
+  fTimeMin = tmin;
+  fTimeMax = tmax;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StackFilter::AddRule(const G4String& particle, G4double emax,
+                            const G4String& volume, G4bool defer)
+{
+  Rule rule;
+  rule.fParticle = 0;
+  if (particle != "all") {
+    rule.fParticle = G4ParticleTable::GetParticleTable()->FindParticle(particle);
+    if (! rule.fParticle) {
+      G4ExceptionDescription msg;
+      msg << "Unknown particle " << particle << ", rule ignored.";
+      G4Exception("B1StackFilter::AddRule()", "B1Stack0001", JustWarning, msg);
+      return;
+    }
+  }
+  rule.fEmax   = emax;
+  rule.fVolume = ( volume == "all" ) ? G4String() : volume;
+  rule.fDefer  = defer;
+  fRules.push_back(rule);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4ClassificationOfNewTrack
+B1StackFilter::Classify(const G4Track* track, G4int& counter) const
+{
+  counter = -1;
+  if (! fEnabled || track->GetParentID() == 0) return fUrgent;
+
+  const B1TrackInformation* info
+    = static_cast<const B1TrackInformation*>(track->GetUserInformation());
+  if (info && info->IsSplitCopy()) return fUrgent;
+
+  const G4ParticleDefinition* particle = track->GetDefinition();
+
+  if (fKillNeutrinos && particle->GetParticleType() == "lepton"
+      && particle->GetPDGCharge() == 0.) {
+    counter = kNeutrino;
+    return fKill;
+  }
+
+  // a ground state with no lifetime is stable; the excited and the
+  // radioactive ions still decay and are kept
+  if (fKillStableIons && particle->IsGeneralIon()
+      && static_cast<const G4Ions*>(particle)->GetExcitationEnergy() == 0.
+      && particle->GetPDGLifeTime() < 0.) {
+    counter = kStableIon;
+    return fKill;
+  }
+
+  G4double time = track->GetGlobalTime();
+  if (fTimeMax > fTimeMin && ( time < fTimeMin || time > fTimeMax )) {
+    counter = kTimeWindow;
+    return fKill;
+  }
+
+  G4double energy = track->GetKineticEnergy();
+  const G4VPhysicalVolume* volume = track->GetVolume();
+  for (size_t i = 0; i < fRules.size(); ++i) {
+    const Rule& rule = fRules[i];
+    if (rule.fParticle && rule.fParticle != particle) continue;
+    if (rule.fEmax > 0. && energy >= rule.fEmax) continue;
+    if (! rule.fVolume.empty()
+        && ( ! volume || volume->GetName() != rule.fVolume )) continue;
+    counter = rule.fDefer ? kRuleDefer : kRuleKill;
+    return rule.fDefer ? fWaiting : fKill;
+  }
+
+  return fUrgent;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const char* B1StackFilter::GetCounterName(G4int counter)
+{
+  static const char* names[kNofCounters] = {
+    "neutrinos", "stable ions", "outside the time window",
+    "killed by rules", "deferred by rules"
+  };
+  return ( counter >= 0 && counter < kNofCounters ) ? names[counter] : "";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StackFilter::Print() const
+{
+  G4cout << "\n Stacking filter " << ( fEnabled ? "on" : "off" )
+         << ", neutrinos " << ( fKillNeutrinos ? "killed" : "kept" )
+         << ", stable ions " << ( fKillStableIons ? "killed" : "kept" )
+         << G4endl;
+  if (fTimeMax > fTimeMin) {
+    G4cout << "   time window : " << G4BestUnit(fTimeMin,"Time")
+           << " - " << G4BestUnit(fTimeMax,"Time") << G4endl;
+  }
+  for (size_t i = 0; i < fRules.size(); ++i) {
+    const Rule& rule = fRules[i];
+    G4cout << "   " << ( rule.fDefer ? "defer " : "kill " )
+           << ( rule.fParticle ? rule.fParticle->GetParticleName()
+                               : G4String("all") );
+    if (rule.fEmax > 0.) G4cout << " below " << G4BestUnit(rule.fEmax,"Energy");
+    if (! rule.fVolume.empty()) G4cout << " in " << rule.fVolume;
+    G4cout << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
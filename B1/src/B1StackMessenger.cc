@@ -0,0 +1,188 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1StackMessenger.cc
+/// \brief Implementation of the B1StackMessenger class
+
+#include "B1StackMessenger.hh"
+#include "B1StackFilter.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4Tokenizer.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StackMessenger::B1StackMessenger(B1StackFilter* filter)
+ : G4UImessenger(),
+   fFilter(filter),
+   fStackDir(0),
+   fEnableCmd(0), fNeutrinoCmd(0), fStableIonCmd(0), fTimeWindowCmd(0),
+   fKillCmd(0), fDeferCmd(0), fClearCmd(0), fPrintCmd(0)
+{
+  fStackDir = new G4UIdirectory("/B1/stack/");
+  fStackDir->SetGuidance("Secondaries killed or deferred before being tracked");
+
+  fEnableCmd = new G4UIcmdWithABool("/B1/stack/enable",this);
+  fEnableCmd->SetGuidance("Filter the new secondaries (on by default).");
+  fEnableCmd->SetParameterName("flag",true);
+  fEnableCmd->SetDefaultValue(true);
+  fEnableCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fEnableCmd->SetToBeBroadcasted(false);
+
+  fNeutrinoCmd = new G4UIcmdWithABool("/B1/stack/killNeutrinos",this);
+  fNeutrinoCmd->SetGuidance("Kill the neutrinos and antineutrinos (default).");
+  fNeutrinoCmd->SetParameterName("flag",true);
+  fNeutrinoCmd->SetDefaultValue(true);
+  fNeutrinoCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fNeutrinoCmd->SetToBeBroadcasted(false);
+
+  fStableIonCmd = new G4UIcmdWithABool("/B1/stack/killStableIons",this);
+  fStableIonCmd->SetGuidance("Kill the stable ions in their ground state, as the");
+  fStableIonCmd->SetGuidance("Fe-57 recoil of the Co-57 decay (default).");
+  fStableIonCmd->SetParameterName("flag",true);
+  fStableIonCmd->SetDefaultValue(true);
+  fStableIonCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fStableIonCmd->SetToBeBroadcasted(false);
+
+  fTimeWindowCmd = new G4UIcommand("/B1/stack/timeWindow",this);
+  fTimeWindowCmd->SetGuidance("Kill the secondaries created outside a global time");
+  fTimeWindowCmd->SetGuidance("window; tmax <= tmin removes the window.");
+  fTimeWindowCmd->SetGuidance("The Co-57 decays at a random time of the order of its");
+  fTimeWindowCmd->SetGuidance("lifetime (~390 days), and its daughters carry that");
+  fTimeWindowCmd->SetGuidance("global time: a window of a few ns kills the whole");
+  fTimeWindowCmd->SetGuidance("decay chain.");
+  G4UIparameter* tminPrm = new G4UIparameter("tmin",'d',false);
+  fTimeWindowCmd->SetParameter(tminPrm);
+  G4UIparameter* tmaxPrm = new G4UIparameter("tmax",'d',false);
+  fTimeWindowCmd->SetParameter(tmaxPrm);
+  G4UIparameter* unitPrm = new G4UIparameter("unit",'s',true);
+  unitPrm->SetDefaultUnit("ns");
+  fTimeWindowCmd->SetParameter(unitPrm);
+  fTimeWindowCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fTimeWindowCmd->SetToBeBroadcasted(false);
+
+  fKillCmd  = CreateRuleCommand("/B1/stack/kill", "Kill");
+  fDeferCmd = CreateRuleCommand("/B1/stack/defer",
+                                "Defer to the waiting stack");
+
+  fClearCmd = new G4UIcmdWithoutParameter("/B1/stack/clearRules",this);
+  fClearCmd->SetGuidance("Remove the kill and defer rules.");
+  fClearCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fClearCmd->SetToBeBroadcasted(false);
+
+  fPrintCmd = new G4UIcmdWithoutParameter("/B1/stack/print",this);
+  fPrintCmd->SetGuidance("Print the stacking filter.");
+  fPrintCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fPrintCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StackMessenger::~B1StackMessenger()
+{
+  delete fPrintCmd;
+  delete fClearCmd;
+  delete fDeferCmd;
+  delete fKillCmd;
+  delete fTimeWindowCmd;
+  delete fStableIonCmd;
+  delete fNeutrinoCmd;
+  delete fEnableCmd;
+  delete fStackDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4UIcommand* B1StackMessenger::CreateRuleCommand(const G4String& name,
+                                                 const G4String& action)
+{
+  G4UIcommand* command = new G4UIcommand(name,this);
+  command->SetGuidance(action + " the secondaries of a particle type (or all),");
+  command->SetGuidance("below a kinetic energy (0: any) and created in a");
+  command->SetGuidance("physical volume (or all). The first matching rule applies.");
+  G4UIparameter* particlePrm = new G4UIparameter("particle",'s',false);
+  command->SetParameter(particlePrm);
+  G4UIparameter* emaxPrm = new G4UIparameter("emax",'d',true);
+  emaxPrm->SetDefaultValue(0.);
+  emaxPrm->SetParameterRange("emax>=0.");
+  command->SetParameter(emaxPrm);
+  G4UIparameter* unitPrm = new G4UIparameter("unit",'s',true);
+  unitPrm->SetDefaultUnit("keV");
+  command->SetParameter(unitPrm);
+  G4UIparameter* volumePrm = new G4UIparameter("volume",'s',true);
+  volumePrm->SetDefaultValue("all");
+  command->SetParameter(volumePrm);
+  command->AvailableForStates(G4State_PreInit,G4State_Idle);
+  command->SetToBeBroadcasted(false);
+  return command;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StackMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fEnableCmd) {
+    fFilter->SetEnabled(fEnableCmd->GetNewBoolValue(newValue));
+  }
+
+  if (command == fNeutrinoCmd) {
+    fFilter->SetKillNeutrinos(fNeutrinoCmd->GetNewBoolValue(newValue));
+  }
+
+  if (command == fStableIonCmd) {
+    fFilter->SetKillStableIons(fStableIonCmd->GetNewBoolValue(newValue));
+  }
+
+  if (command == fTimeWindowCmd) {
+    G4Tokenizer next(newValue);
+    G4double tmin = G4UIcommand::ConvertToDouble(next());
+    G4double tmax = G4UIcommand::ConvertToDouble(next());
+    G4double unit = G4UIcommand::ValueOf(next());
+    fFilter->SetTimeWindow(tmin*unit, tmax*unit);
+  }
+
+  if (command == fKillCmd || command == fDeferCmd) {
+    G4Tokenizer next(newValue);
+    G4String particle = next();
+    G4double emax = G4UIcommand::ConvertToDouble(next());
+    emax *= G4UIcommand::ValueOf(next());
+    G4String volume = next();
+    fFilter->AddRule(particle, emax, volume, command == fDeferCmd);
+  }
+
+  if (command == fClearCmd) {
+    fFilter->ClearRules();
+  }
+
+  if (command == fPrintCmd) {
+    fFilter->Print();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -23,25 +23,35 @@
 // * acceptance of all terms of the Geant4 Software license.          *
 // ********************************************************************
 //
-//
 /// \file B1SteppingAction.cc
 /// \brief Implementation of the B1SteppingAction class
 
 #include "B1SteppingAction.hh"
-#include "B1EventAction.hh"
-#include "B1DetectorConstruction.hh"
+#include "B1Profiler.hh"
+#include "B1ImportanceMap.hh"
+#include "B1HistoryTree.hh"
+#include "B1TrackInformation.hh"
 
 #include "G4Step.hh"
-#include "G4Event.hh"
-#include "G4RunManager.hh"
-#include "G4LogicalVolume.hh"
+#include "G4Track.hh"
+#include "G4SteppingManager.hh"
+#include "G4DynamicParticle.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "Randomize.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-B1SteppingAction::B1SteppingAction(B1EventAction* eventAction)
+B1SteppingAction::B1SteppingAction(B1Profiler* profiler,
+                                   const B1ImportanceMap* importance,
+                                   B1HistoryTree* history)
 : G4UserSteppingAction(),
-  fEventAction(eventAction),
-  fScoringVolume(0)
+  fProfiler(profiler),
+  fImportance(importance),
+  fHistory(history),
+  fNofSecondaries(0),
+  fCrystal(0),
+  fVolumeImportance()
 {}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -53,25 +63,148 @@ B1SteppingAction::~B1SteppingAction()
 
 void B1SteppingAction::UserSteppingAction(const G4Step* step)
 {
-  if (!fScoringVolume) { 
-    const B1DetectorConstruction* detectorConstruction
-      = static_cast<const B1DetectorConstruction*>
-        (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
-    fScoringVolume = detectorConstruction->GetScoringVolume();   
+  if (fProfiler->IsStepTimingEnabled()) fProfiler->AddStep(step);
+  if (fImportance->IsActive()) SampleImportance(step);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1SteppingAction::IsNeeded() const
+{
+  return fProfiler->IsStepTimingEnabled() || fImportance->IsActive();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1SteppingAction::BeginOfRun()
+{
+  // the geometry may have been rebuilt since the previous run
+  fCrystal = 0;
+  fVolumeImportance.clear();
+  if (! fImportance->IsActive()) return;
+
+  G4PhysicalVolumeStore* store = G4PhysicalVolumeStore::GetInstance();
+  for (std::size_t i = 0; i < store->size(); ++i) {
+    const G4VPhysicalVolume* volume = (*store)[i];
+    fVolumeImportance[volume] = fImportance->GetImportance(volume);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1SteppingAction::GetImportance(const G4VPhysicalVolume* volume) const
+{
+  std::map<const G4VPhysicalVolume*, G4double>::const_iterator it
+    = fVolumeImportance.find(volume);
+  return ( it != fVolumeImportance.end() ) ? it->second : 1.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1SteppingAction::SampleImportance(const G4Step* step)
+{
+  G4Track* track = step->GetTrack();
+  B1TrackInformation* info
+    = static_cast<B1TrackInformation*>(track->GetUserInformation());
+
+  // the secondaries of this step belong to the branch of their parent
+  G4TrackVector* secondaries = fpSteppingManager->GetfSecondary();
+  if (track->GetCurrentStepNumber() == 1) fNofSecondaries = 0;
+  if (info) {
+    for (std::size_t i = fNofSecondaries; i < secondaries->size(); ++i) {
+      (*secondaries)[i]->SetUserInformation(
+        new B1TrackInformation(info->GetBranch(), info->GetImportance()));
+    }
   }
+  fNofSecondaries = secondaries->size();
 
-  // get volume of the current step
-  G4LogicalVolume* volume 
-    = step->GetPreStepPoint()->GetTouchableHandle()
-      ->GetVolume()->GetLogicalVolume();
-      
-  // check if we are in scoring volume
-  if (volume != fScoringVolume) return;
-
-  // collect energy deposited in this step
-  G4double edepStep = step->GetTotalEnergyDeposit();
-  fEventAction->AddEdep(edepStep);  
+  const G4StepPoint* postStepPoint = step->GetPostStepPoint();
+  if (postStepPoint->GetStepStatus() != fGeomBoundary) return;
+  if (track->GetTrackStatus() != fAlive) return;
+  const G4VPhysicalVolume* next = postStepPoint->GetPhysicalVolume();
+  if (! next) return;
+  // the decaying ions are left alone
+  if (track->GetDefinition()->IsGeneralIon()) return;
+
+  G4int branch = info ? info->GetBranch() : 0;
+  G4double current = info ? info->GetImportance() : 1.;
+  G4double importance = GetImportance(next);
+  G4double ratio = importance/current;
+  if (ratio == 1.) return;
+
+  G4bool inwards = IsMovingTowardsCrystal(track);
+  if (ratio > 1. && inwards) {
+    // about ratio copies on average, at most maxSplit
+    G4int nofCopies = G4int(ratio);
+    if (G4UniformRand() < ratio - nofCopies) ++nofCopies;
+    if (nofCopies > fImportance->GetMaxSplit()) {
+      nofCopies = fImportance->GetMaxSplit();
+    }
+    if (nofCopies > 1) SplitTrack(track, branch, nofCopies, importance);
+  }
+  else if (ratio < 1. && ! inwards) {
+    if (G4UniformRand() < ratio) {
+      G4int survivor = fHistory->Survive(branch, ratio);
+      if (! info) {
+        info = new B1TrackInformation(survivor, importance);
+        track->SetUserInformation(info);
+      }
+      info->SetBranch(survivor);
+      info->SetImportance(importance);
+    }
+    else {
+      track->SetTrackStatus(fStopAndKill);
+    }
+  }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void B1SteppingAction::SplitTrack(G4Track* track, G4int branch,
+                                  G4int nofCopies, G4double importance)
+{
+  G4int first = fHistory->Split(branch, nofCopies);
+
+  // the track goes on as the first copy
+  B1TrackInformation* info
+    = static_cast<B1TrackInformation*>(track->GetUserInformation());
+  if (! info) {
+    info = new B1TrackInformation(first, importance);
+    track->SetUserInformation(info);
+  }
+  info->SetBranch(first);
+  info->SetImportance(importance);
+
+  // the others are pushed as secondaries, on the boundary
+  G4TrackVector* secondaries = fpSteppingManager->GetfSecondary();
+  for (G4int i = 1; i < nofCopies; ++i) {
+    G4Track* copy
+      = new G4Track(new G4DynamicParticle(*track->GetDynamicParticle()),
+                    track->GetGlobalTime(), track->GetPosition());
+    copy->SetWeight(track->GetWeight());
+    copy->SetParentID(track->GetTrackID());
+    copy->SetCreatorProcess(track->GetCreatorProcess());
+    copy->SetTouchableHandle(track->GetNextTouchableHandle());
+    copy->SetUserInformation(
+      new B1TrackInformation(first + i, importance, true));
+    secondaries->push_back(copy);
+  }
+  fNofSecondaries = secondaries->size();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1SteppingAction::IsMovingTowardsCrystal(const G4Track* track)
+{
+  // In order to avoid dependence on DetectorConstruction class
+  // the crystal is taken from G4PhysicalVolumeStore.
+  // The Envelope is placed at the origin, so its translation is global.
+  if (! fCrystal) {
+    fCrystal = G4PhysicalVolumeStore::GetInstance()->GetVolume("Shape1_1", false);
+    if (! fCrystal) return true;
+  }
+  G4ThreeVector towards = fCrystal->GetTranslation() - track->GetPosition();
+  return towards.dot(track->GetMomentumDirection()) > 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,136 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1StopCondition.cc
+/// \brief Implementation of the B1StopCondition class
+
+#include "B1StopCondition.hh"
+#include "B1StopMessenger.hh"
+
+#include "G4AutoLock.hh"
+#include "G4UnitsTable.hh"
+#include "G4ios.hh"
+
+#include <cmath>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StopCondition::B1StopCondition()
+: fMessenger(0),
+  fPrecision(0.),
+  fRoiMin(0.), fRoiMax(0.),
+  fSideMin(0.), fSideMax(0.),
+  fSubtractBackground(false),
+  fCheckInterval(1000),
+  fMinEvents(10000),
+  fMutex(),
+  fTotal(),
+  fReached(false)
+{
+  fMessenger = new B1StopMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StopCondition::~B1StopCondition()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StopCondition::SetRoi(G4double emin, G4double emax)
+{
+  fRoiMin = emin;
+  fRoiMax = emax;
+  G4double halfWidth = 0.5*(emax - emin);
+  fSideMin = emin - halfWidth;
+  fSideMax = emax + halfWidth;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StopCondition::Reset()
+{
+  G4AutoLock lock(&fMutex);
+  fTotal = Sums();
+  fReached = false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1StopCondition::Publish(Sums& sums)
+{
+  G4AutoLock lock(&fMutex);
+  fTotal.fNofEvents += sums.fNofEvents;
+  fTotal.fRoiW      += sums.fRoiW;
+  fTotal.fRoiW2     += sums.fRoiW2;
+  fTotal.fSideW     += sums.fSideW;
+  fTotal.fSideW2    += sums.fSideW2;
+  sums = Sums();
+
+  if (! fReached && IsActive() && fTotal.fNofEvents >= fMinEvents) {
+    G4double area, error;
+    G4double relError = RelativeError(area, error);
+    if (relError >= 0. && relError <= fPrecision) fReached = true;
+  }
+  return fReached;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1StopCondition::RelativeError(G4double& area, G4double& error) const
+{
+  // the side bands have the width of the ROI in total
+  area = fTotal.fRoiW;
+  G4double variance = fTotal.fRoiW2;
+  if (fSubtractBackground) {
+    area -= fTotal.fSideW;
+    variance += fTotal.fSideW2;
+  }
+  error = std::sqrt(variance);
+  return area > 0. ? error/area : -1.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StopCondition::Report() const
+{
+  if (! IsActive()) return;
+
+  G4double area, error;
+  G4double relError = RelativeError(area, error);
+  G4cout
+    << " Precision target " << fPrecision << " on the "
+    << ( fSubtractBackground ? "net" : "gross" ) << " area in ["
+    << G4BestUnit(fRoiMin,"Energy") << ", " << G4BestUnit(fRoiMax,"Energy")
+    << "] " << ( IsReached() ? "reached" : "not reached" )
+    << " after " << fTotal.fNofEvents << " events" << G4endl
+    << " area = " << area << " +- " << error;
+  if (relError >= 0.) G4cout << " (relative " << relError << ")";
+  G4cout << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,147 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1StopMessenger.cc
+/// \brief Implementation of the B1StopMessenger class
+
+#include "B1StopMessenger.hh"
+#include "B1StopCondition.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4Tokenizer.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StopMessenger::B1StopMessenger(B1StopCondition* stop)
+ : G4UImessenger(),
+   fStop(stop),
+   fStopDir(0),
+   fPrecisionCmd(0), fRoiCmd(0), fBackgroundCmd(0),
+   fCheckEveryCmd(0), fMinEventsCmd(0)
+{
+  fStopDir = new G4UIdirectory("/B1/stop/");
+  fStopDir->SetGuidance("Stop the run on a precision target");
+
+  fPrecisionCmd = new G4UIcmdWithADouble("/B1/stop/precision",this);
+  fPrecisionCmd->SetGuidance("Stop the run once the relative uncertainty of the");
+  fPrecisionCmd->SetGuidance("ROI area is below this value; /run/beamOn then gives");
+  fPrecisionCmd->SetGuidance("the maximum number of events. 0 switches it off.");
+  fPrecisionCmd->SetParameterName("relError",false);
+  fPrecisionCmd->SetRange("relError>=0.");
+  fPrecisionCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fPrecisionCmd->SetToBeBroadcasted(false);
+
+  fRoiCmd = new G4UIcommand("/B1/stop/roi",this);
+  fRoiCmd->SetGuidance("Set the region of interest of the Edep spectrum,");
+  fRoiCmd->SetGuidance("e.g. /B1/stop/roi 14.2 14.6 keV for the 14.4 keV line.");
+  G4UIparameter* eminPrm = new G4UIparameter("emin",'d',false);
+  eminPrm->SetParameterRange("emin>=0.");
+  fRoiCmd->SetParameter(eminPrm);
+  G4UIparameter* emaxPrm = new G4UIparameter("emax",'d',false);
+  emaxPrm->SetParameterRange("emax>0.");
+  fRoiCmd->SetParameter(emaxPrm);
+  G4UIparameter* unitPrm = new G4UIparameter("unit",'s',true);
+  unitPrm->SetDefaultUnit("keV");
+  fRoiCmd->SetParameter(unitPrm);
+  fRoiCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fRoiCmd->SetToBeBroadcasted(false);
+
+  fBackgroundCmd = new G4UIcmdWithABool("/B1/stop/background",this);
+  fBackgroundCmd->SetGuidance("Subtract the background estimated from two side bands");
+  fBackgroundCmd->SetGuidance("of half the ROI width on each side (off by default).");
+  fBackgroundCmd->SetParameterName("flag",true);
+  fBackgroundCmd->SetDefaultValue(true);
+  fBackgroundCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fBackgroundCmd->SetToBeBroadcasted(false);
+
+  fCheckEveryCmd = new G4UIcmdWithAnInteger("/B1/stop/checkEvery",this);
+  fCheckEveryCmd->SetGuidance("Number of events of a thread between two checks.");
+  fCheckEveryCmd->SetParameterName("nEvents",false);
+  fCheckEveryCmd->SetRange("nEvents>0");
+  fCheckEveryCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fCheckEveryCmd->SetToBeBroadcasted(false);
+
+  fMinEventsCmd = new G4UIcmdWithAnInteger("/B1/stop/minEvents",this);
+  fMinEventsCmd->SetGuidance("Minimum number of events before the run can stop.");
+  fMinEventsCmd->SetParameterName("nEvents",false);
+  fMinEventsCmd->SetRange("nEvents>=0");
+  fMinEventsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fMinEventsCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StopMessenger::~B1StopMessenger()
+{
+  delete fMinEventsCmd;
+  delete fCheckEveryCmd;
+  delete fBackgroundCmd;
+  delete fRoiCmd;
+  delete fPrecisionCmd;
+  delete fStopDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StopMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fPrecisionCmd) {
+    fStop->SetPrecision(fPrecisionCmd->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fRoiCmd) {
+    G4Tokenizer next(newValue);
+    G4double emin = G4UIcommand::ConvertToDouble(next());
+    G4double emax = G4UIcommand::ConvertToDouble(next());
+    G4double unit = G4UIcommand::ValueOf(next());
+    if (emax <= emin) {
+      G4ExceptionDescription msg;
+      msg << "Empty ROI [" << emin << ", " << emax << "], ignored.";
+      G4Exception("B1StopMessenger::SetNewValue()",
+                  "B1Stop0001", JustWarning, msg);
+      return;
+    }
+    fStop->SetRoi(emin*unit, emax*unit);
+  }
+
+  if (command == fBackgroundCmd) {
+    fStop->SetBackgroundSubtraction(fBackgroundCmd->GetNewBoolValue(newValue));
+  }
+
+  if (command == fCheckEveryCmd) {
+    fStop->SetCheckInterval(fCheckEveryCmd->GetNewIntValue(newValue));
+  }
+
+  if (command == fMinEventsCmd) {
+    fStop->SetMinEvents(fMinEventsCmd->GetNewIntValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
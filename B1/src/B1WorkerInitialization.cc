@@ -0,0 +1,178 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file B1WorkerInitialization.cc
+/// \brief Implementation of the B1WorkerInitialization class
+
+#include "B1WorkerInitialization.hh"
+
+#include "G4Threading.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+// Parses a kernel CPU or node list such as "0-3,8-11"
+std::vector<G4int> ParseCpuList(const std::string& list)
+{
+  std::vector<G4int> cpus;
+  std::istringstream is(list);
+  std::string range;
+  while ( std::getline(is, range, ',') ) {
+    if ( range.empty() || range == "\n" ) continue;
+    std::size_t dash = range.find('-');
+    G4int first = std::atoi(range.substr(0, dash).c_str());
+    G4int last = ( dash == std::string::npos )
+               ? first : std::atoi(range.substr(dash+1).c_str());
+    for ( G4int cpu = first; cpu <= last; ++cpu ) cpus.push_back(cpu);
+  }
+  return cpus;
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1WorkerInitialization::B1WorkerInitialization(AffinityMode mode)
+: G4UserWorkerInitialization(),
+  fMode(mode),
+  fCpus(),
+  fNodes()
+{
+  // The mask is read here, on the master thread, before any worker exists
+  ReadCpuSet();
+  ReadNodes();
+
+  G4cout << "Worker affinity: "
+         << ( fMode == kAffinityNuma ? "numa" : "core" ) << " mode, "
+         << fCpus.size() << " CPUs on " << fNodes.size()
+         << " NUMA node(s) available" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1WorkerInitialization::~B1WorkerInitialization()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1WorkerInitialization::ReadCpuSet()
+{
+#ifdef __linux__
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if ( sched_getaffinity(0, sizeof(mask), &mask) == 0 ) {
+    for ( G4int cpu = 0; cpu < CPU_SETSIZE; ++cpu ) {
+      if ( CPU_ISSET(cpu, &mask) ) fCpus.push_back(cpu);
+    }
+  }
+#endif
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1WorkerInitialization::ReadNodes()
+{
+  // The online node ids need not be contiguous (offline or absent
+  // nodes), so they are read from the node list rather than counted.
+  // Nodes without any CPU of the mask are skipped; without NUMA
+  // information all CPUs form a single node
+  std::ifstream online("/sys/devices/system/node/online");
+  std::string nodeList;
+  if ( online ) std::getline(online, nodeList);
+  std::vector<G4int> nodes = ParseCpuList(nodeList);
+
+  for ( std::size_t n = 0; n < nodes.size(); ++n ) {
+    std::ostringstream name;
+    name << "/sys/devices/system/node/node" << nodes[n] << "/cpulist";
+    std::ifstream file(name.str().c_str());
+    if ( ! file ) continue;
+    std::string list;
+    std::getline(file, list);
+
+    std::vector<G4int> cpus;
+    std::vector<G4int> nodeCpus = ParseCpuList(list);
+    for ( std::size_t i = 0; i < nodeCpus.size(); ++i ) {
+      if ( std::find(fCpus.begin(), fCpus.end(), nodeCpus[i]) != fCpus.end() )
+        cpus.push_back(nodeCpus[i]);
+    }
+    if ( ! cpus.empty() ) fNodes.push_back(cpus);
+  }
+  if ( fNodes.empty() && ! fCpus.empty() ) fNodes.push_back(fCpus);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1WorkerInitialization::WorkerStart() const
+{
+  if ( fMode == kAffinityNone ) return;
+
+#ifdef __linux__
+  if ( fCpus.empty() ) return;
+
+  G4int id = G4Threading::G4GetThreadId();
+  if ( id < 0 ) id = 0;
+
+  // core mode: CPU id of the cpuset, node by node so that neighbouring
+  // workers share a node; numa mode: all the CPUs of node id
+  std::vector<G4int> cpus;
+  if ( fMode == kAffinityCore ) {
+    std::vector<G4int> ordered;
+    for ( std::size_t i = 0; i < fNodes.size(); ++i )
+      ordered.insert(ordered.end(), fNodes[i].begin(), fNodes[i].end());
+    cpus.push_back(ordered[id % ordered.size()]);
+  }
+  else {
+    cpus = fNodes[id % fNodes.size()];
+  }
+
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for ( std::size_t i = 0; i < cpus.size(); ++i ) CPU_SET(cpus[i], &mask);
+  if ( pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask) != 0 ) {
+    G4ExceptionDescription msg;
+    msg << "Worker " << id << " could not be pinned, it stays unpinned.";
+    G4Exception("B1WorkerInitialization::WorkerStart()",
+                "B1Affinity0001", JustWarning, msg);
+    return;
+  }
+
+  G4cout << "Worker " << id << " pinned to CPU";
+  if ( cpus.size() > 1 ) G4cout << "s";
+  for ( std::size_t i = 0; i < cpus.size(); ++i ) G4cout << " " << cpus[i];
+  G4cout << G4endl;
+#endif
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......